@@ -0,0 +1,162 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_ALARM_MONITOR_HPP
+#define OPENSEEKTHERMAL_ALARM_MONITOR_HPP
+
+#include "./processing_stage.hpp"
+#include "./roi_statistics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace openseekthermal
+{
+
+enum class AlarmStatistic { Max, Min, Mean };
+
+enum class AlarmCondition { Above, Below };
+
+/*!
+ * A radiometric alarm on a statistic of a region, in the units of the
+ * analyzed frame (centi-Kelvin after the "temperature" stage).
+ *
+ * An Above rule is met while the statistic is at or above `threshold` and
+ * stays met until it drops below `threshold - hysteresis`; a Below rule
+ * mirrors this. The alarm raises once the rule was met for `min_duration`
+ * and clears as soon as it is no longer met.
+ */
+struct AlarmRule {
+  std::string name;
+  //! In the coordinates of the analyzer, the sensor's for an AlarmStage. An
+  //! empty region selects the whole frame.
+  RegionOfInterest roi;
+  AlarmStatistic statistic = AlarmStatistic::Max;
+  AlarmCondition condition = AlarmCondition::Above;
+  double threshold = 0.0;
+  double hysteresis = 0.0;
+  std::chrono::milliseconds min_duration{ 0 };
+};
+
+//! A change of the state of an AlarmRule.
+struct AlarmEvent {
+  size_t rule = 0; //!< Index of the rule in AlarmMonitor::rules().
+  std::string name;
+  bool active = false; //!< Whether the alarm was raised or cleared.
+  double value = 0.0;  //!< The statistic in the frame that changed the state.
+  std::chrono::steady_clock::time_point time;
+};
+
+/*!
+ * Evaluates a set of AlarmRules once per frame and reports only state
+ * changes, so applications can sleep until something happens instead of
+ * polling every frame.
+ *
+ * Changes are delivered to the callback, invoked from the evaluating thread,
+ * and queued for takeEvents(). The queue is signalled on eventFd(), a Linux
+ * eventfd that becomes readable while events are pending, so application
+ * threads can wait on it with poll() or an event loop.
+ *
+ * All methods are thread-safe.
+ */
+class AlarmMonitor
+{
+public:
+  using Callback = std::function<void( const AlarmEvent & )>;
+
+  //! Events are dropped, oldest first, beyond this many pending events.
+  static constexpr size_t kMaxPendingEvents = 256;
+
+  //! @throws std::system_error if the eventfd cannot be created.
+  AlarmMonitor();
+
+  ~AlarmMonitor();
+
+  AlarmMonitor( const AlarmMonitor & ) = delete;
+  AlarmMonitor &operator=( const AlarmMonitor & ) = delete;
+
+  //! Replace the rules. All alarms start cleared.
+  void setRules( std::vector<AlarmRule> rules );
+
+  std::vector<AlarmRule> rules() const;
+
+  size_t ruleCount() const noexcept { return rule_count_.load( std::memory_order_relaxed ); }
+
+  //! Set the callback invoked on every state change. It runs in the
+  //! evaluating thread, i.e. the grabbing thread for an AlarmStage, and
+  //! should return quickly.
+  void setCallback( Callback callback );
+
+  //! Evaluate the rules on the frame analyzed by `analyzer` at `time`.
+  void evaluate( const RoiAnalyzer &analyzer, std::chrono::steady_clock::time_point time );
+
+  //! Whether the alarm of the rule with index `rule` is raised.
+  bool active( size_t rule ) const;
+
+  //! Readable while events are pending. Owned by the monitor; do not close.
+  int eventFd() const noexcept { return event_fd_; }
+
+  //! Remove and return the pending events, oldest first.
+  std::vector<AlarmEvent> takeEvents();
+
+private:
+  struct RuleState {
+    bool met = false;
+    bool active = false;
+    std::chrono::steady_clock::time_point met_since;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<AlarmRule> rules_;
+  std::vector<RuleState> states_;
+  Callback callback_;
+  std::deque<AlarmEvent> pending_;
+  std::atomic<size_t> rule_count_{ 0 };
+  int event_fd_ = -1;
+};
+
+/*!
+ * Analysis stage (see ProcessingStage) that evaluates an AlarmMonitor on the
+ * frame at its position in the chain:
+ *
+ *     auto alarms = std::make_shared<AlarmStage>();
+ *     AlarmRule rule;
+ *     rule.name = "bearing";
+ *     rule.roi = { 120, 80, 16, 16 };
+ *     rule.threshold = 100 * 80 + 27315; // 80 °C
+ *     rule.hysteresis = 200;
+ *     rule.min_duration = std::chrono::seconds( 2 );
+ *     alarms->monitor().setRules( { rule } );
+ *     camera->addProcessingStage( alarms, "" );
+ *
+ * Rules are evaluated at the end of every thermal frame in the grabbing
+ * thread. The stage is disabled while there are no rules.
+ */
+class AlarmStage : public ProcessingStage
+{
+public:
+  explicit AlarmStage( int pyramid_levels = 4 ) : analyzer_( pyramid_levels ) { }
+
+  const char *name() const noexcept override { return "alarms"; }
+
+  bool enabled() const noexcept override { return monitor_.ruleCount() > 0; }
+
+  void process( const StageRows &rows ) override;
+
+  AlarmMonitor &monitor() noexcept { return monitor_; }
+
+  const AlarmMonitor &monitor() const noexcept { return monitor_; }
+
+private:
+  RoiAnalyzer analyzer_;
+  AlarmMonitor monitor_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_ALARM_MONITOR_HPP
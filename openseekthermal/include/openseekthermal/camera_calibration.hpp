@@ -5,6 +5,8 @@
 #define OPENSEEKTHERMAL_CAMERA_CALIBRATION_HPP
 
 #include "dead_pixel_mask.hpp"
+#include "distortion_correction.hpp"
+#include "non_uniformity_correction.hpp"
 #include "temperature_calibration.hpp"
 #include "vignette_correction.hpp"
 
@@ -16,28 +18,35 @@ namespace openseekthermal
 {
 
 /*!
- * Bundled per-unit calibration: temperature mapping, vignette polynomial, and
- * dead-pixel list. All three are optional; omitted sections leave the
- * corresponding correction disabled.
+ * Bundled per-unit calibration: temperature mapping, vignette polynomial,
+ * dead-pixel list, per-pixel gain / offset tables and lens distortion model.
+ * All are optional; omitted sections leave the corresponding correction
+ * disabled.
  *
  * Loaded from / written to a single INI file with `[temperature]`,
- * `[vignette]`, `[dead_pixels]` sections via loadCameraCalibration() /
- * saveCameraCalibration().
+ * `[vignette]`, `[dead_pixels]`, `[non_uniformity]`, `[distortion]` sections via
+ * loadCameraCalibration() / saveCameraCalibration().
  */
 struct CameraCalibration {
   std::optional<TemperatureCalibration> temperature;
   std::optional<VignetteCorrection> vignette;
   std::optional<DeadPixelMask> dead_pixels;
+  std::optional<DistortionCorrection> distortion;
+  std::optional<NonUniformityCorrection> non_uniformity;
 };
 
 /*!
- * Load a unified calibration file. Empty / missing sections become
- * `std::nullopt`. If `[vignette]` or `[dead_pixels]` is present, its width /
- * height must match the camera's frame size.
+ * Load a unified calibration file, INI or binary (see
+ * saveCameraCalibrationBinary(); detected by its magic). Empty / missing
+ * sections become `std::nullopt`. If `[vignette]`, `[dead_pixels]`,
+ * `[non_uniformity]` or `[distortion]` is present, its width / height must
+ * match the camera's frame size. In `[non_uniformity]`, `gain` and `offset`
+ * are width*height values each. In `[distortion]`, fx, fy, cx, cy and k1 are
+ * required; k2, k3, p1 and p2 default to 0.
  *
  * @param path Path to the .ini file.
- * @param expected_width Frame width the vignette / dead-pixel sections must match.
- * @param expected_height Frame height the vignette / dead-pixel sections must match.
+ * @param expected_width Frame width the per-unit sections must match.
+ * @param expected_height Frame height the per-unit sections must match.
  * @throws std::runtime_error on I/O, parse, or dimension errors.
  */
 CameraCalibration loadCameraCalibration( const std::filesystem::path &path, int expected_width,
@@ -51,6 +60,30 @@ CameraCalibration loadCameraCalibration( const std::filesystem::path &path, int
 void saveCameraCalibration( const std::filesystem::path &path, const CameraCalibration &cal,
                             const std::string &header_comment = "" );
 
+/*!
+ * Write `cal` as a binary calibration container: a versioned file of 64-byte
+ * aligned sections with CRC-32 checksums that holds the runtime form of the
+ * calibration, i.e. the compiled vignette offset table, the dead-pixel
+ * entries with their neighbour lists and the Q12 non-uniformity tables. The
+ * INI file remains the editable form; `convert_calibration` converts between
+ * the two.
+ * @throws std::invalid_argument if the sections have different frame sizes.
+ * @throws std::runtime_error on I/O errors.
+ */
+void saveCameraCalibrationBinary( const std::filesystem::path &path, const CameraCalibration &cal );
+
+/*!
+ * Map a binary calibration container. Checksums and bounds are verified, but
+ * nothing is parsed: the dead-pixel mask, the vignette offset table and the
+ * non-uniformity tables point into the mapping, which stays alive as long as they do.
+ * @throws std::runtime_error on I/O, format, checksum or dimension errors.
+ */
+CameraCalibration loadCameraCalibrationBinary( const std::filesystem::path &path,
+                                               int expected_width, int expected_height );
+
+//! Whether `path` is a binary calibration container.
+bool isBinaryCameraCalibration( const std::filesystem::path &path );
+
 } // namespace openseekthermal
 
 #endif // OPENSEEKTHERMAL_CAMERA_CALIBRATION_HPP
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace openseekthermal
@@ -23,6 +24,22 @@ struct DeadPixelEntry {
   uint8_t weights[8] = { 0 };    //!< matching gauss weights
 };
 
+//! Read-only view of the entries of a DeadPixelMask, sorted by index.
+struct DeadPixelEntries {
+  const DeadPixelEntry *data = nullptr;
+  size_t count = 0;
+
+  const DeadPixelEntry *begin() const noexcept { return data; }
+
+  const DeadPixelEntry *end() const noexcept { return data + count; }
+
+  size_t size() const noexcept { return count; }
+
+  bool empty() const noexcept { return count == 0; }
+
+  const DeadPixelEntry &operator[]( size_t i ) const noexcept { return data[i]; }
+};
+
 /*!
  * Sparse representation of a dead-pixel mask. Built once per camera and
  * applied per-frame; touches only the dead pixels themselves.
@@ -47,24 +64,42 @@ public:
    */
   DeadPixelMask( int width, int height, const std::vector<std::pair<int, int>> &dead_coords );
 
+  /*!
+   * Use `count` precomputed entries, sorted by index, without copying them,
+   * e.g. from a memory-mapped binary calibration file. The mask keeps
+   * `entries` alive; copies of the mask share it.
+   */
+  DeadPixelMask( int width, int height, std::shared_ptr<const DeadPixelEntry> entries,
+                 size_t count );
+
   /*!
    * Apply the inpainting in-place to a width*height host-endian uint16
    * frame buffer. No-op for entries with zero valid neighbours.
    */
   void apply( uint16_t *frame ) const;
 
+  /*!
+   * Like apply() restricted to the dead pixels in rows [row_begin, row_end),
+   * reading their neighbours from `input` and writing `frame`. If the two
+   * differ, the rows are copied first. Neighbours are never dead, so the
+   * result does not depend on how a frame is split into row ranges.
+   */
+  void applyRows( const uint16_t *input, uint16_t *frame, int row_begin, int row_end ) const;
+
   int width() const { return width_; }
 
   int height() const { return height_; }
 
-  size_t deadPixelCount() const { return entries_.size(); }
+  size_t deadPixelCount() const { return count_; }
 
-  const std::vector<DeadPixelEntry> &entries() const { return entries_; }
+  DeadPixelEntries entries() const { return { entries_.get(), count_ }; }
 
 private:
   int width_ = 0;
   int height_ = 0;
-  std::vector<DeadPixelEntry> entries_;
+  //! Immutable, so copies of a mask share the entries.
+  std::shared_ptr<const DeadPixelEntry> entries_;
+  size_t count_ = 0;
 };
 
 } // namespace openseekthermal
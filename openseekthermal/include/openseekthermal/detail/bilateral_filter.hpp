@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_BILATERAL_FILTER_HPP
+#define OPENSEEKTHERMAL_BILATERAL_FILTER_HPP
+
+#include "../spatial_filter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openseekthermal
+{
+
+/*!
+ * Integer bilateral filter on host-endian uint16 frames.
+ *
+ * Spatial and range weights are precomputed as Q8 tables; the range table is
+ * indexed by the absolute count difference and ends in a zero entry at the
+ * cutoff, so the per-tap weight is a clamp, a lookup and a multiply. Taps are
+ * the outer loop and columns the inner one, accumulating a whole row at a time
+ * so the inner loop is a straight, vectorizable pass over the row.
+ */
+class BilateralFilter
+{
+public:
+  static constexpr int kMaxRadius = 2;
+
+  BilateralFilter() = default;
+
+  //! Precompute the weight tables. The radius is clamped to [1, kMaxRadius];
+  //! the sigmas must be finite.
+  explicit BilateralFilter( const SpatialFilterSettings &settings );
+
+  int radius() const noexcept { return radius_; }
+
+  /*!
+   * Filter rows [row_begin, row_end) of the width*height frame `src` into the
+   * same rows of `dst`. Reads up to radius() rows above and below; the frame
+   * border is replicated. `src` and `dst` must not overlap.
+   */
+  void filterRows( const uint16_t *src, uint16_t *dst, int width, int height, int row_begin,
+                   int row_end );
+
+private:
+  int radius_ = 1;
+  int range_cutoff_ = 0;
+  //! Q8 spatial weight per tap, row-major over the (2r+1)² window.
+  std::vector<int32_t> spatial_weight_;
+  //! Q8 range weight per absolute difference, 0 at range_cutoff_.
+  std::vector<int32_t> range_weight_;
+  //! Per-row accumulators and the border-replicated source row.
+  std::vector<int32_t> sum_;
+  std::vector<int32_t> weight_sum_;
+  std::vector<uint16_t> padded_row_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_BILATERAL_FILTER_HPP
@@ -5,12 +5,22 @@
 #define OPENSEEKTHERMAL_SEEK_THERMAL_CAMERA_HPP
 
 #include "../../camera_calibration.hpp"
+#include "../../frame_stats.hpp"
+#include "../../metrics.hpp"
+#include "../../roi_statistics.hpp"
+#include "../../spatial_filter.hpp"
+#include "../../temporal_filter.hpp"
 #include "../frame.hpp"
+#include "../frame_pipeline.hpp"
+#include "../frame_stats_accumulator.hpp"
+#include "../processing_pipeline.hpp"
+#include "../sentinel_map.hpp"
 #include "../usb/seek_device.hpp"
 
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -31,6 +41,29 @@ enum class GrabFrameResult {
 
 std::string to_string( GrabFrameResult result );
 
+/*!
+ * Output buffers for SeekThermalCamera::grabFrame( const FrameOutputs & ).
+ * Each is an optional caller-owned buffer of getOutputWidth() *
+ * getOutputHeight() elements; only the
+ * requested representations are computed, all from the same transfer. If
+ * the output size changes while a grab waits for its transfer, e.g. by
+ * setProcessingWindow() from another thread, the grab returns
+ * BUFFER_TOO_SMALL without writing them.
+ */
+struct FrameOutputs {
+  //! Extracted, sentinel-inpainted counts before any correction.
+  uint16_t *raw_counts = nullptr;
+  //! Corrected counts, as returned by grabRawCountsFrame().
+  uint16_t *counts = nullptr;
+  //! Centi-Kelvin, as returned by grabFrame().
+  uint16_t *centi_kelvin = nullptr;
+  //! Float temperatures in `temperature_unit`, as returned by the float grabFrame().
+  float *temperature = nullptr;
+  TemperatureUnit temperature_unit = TemperatureUnit::Celsius;
+  //! Statistics of the frame, see FrameStats. Computed only if set.
+  FrameStats *stats = nullptr;
+};
+
 class SeekThermalCamera
 {
 public:
@@ -61,12 +94,40 @@ public:
    *             Caller has ownership of the data.
    * @param size The size of the image data. Pass the current size of image_data if provided.
    *             If size is smaller than the required size, BUFFER_TOO_SMALL will be returned
-   * without attempting to retrieve a frame.
+   * without attempting to retrieve a frame. It is also returned, without writing
+   * the outputs, if the output size changed during the transfer.
    * @param header Optionally, the frame header can be provided to fill with the frame header data.
+   * @param stats Optionally filled with the min, max, mean, histogram and
+   *        sentinel count of the returned frame, computed during processing.
    * @returns GrabFrameResult indicating the result of the frame grab.
    * @throws USBError Could be thrown if an error occurred during frame transfer.
    */
-  GrabFrameResult grabFrame( unsigned char **image_data, size_t &size, FrameHeader *header = nullptr );
+  GrabFrameResult grabFrame( unsigned char **image_data, size_t &size,
+                             FrameHeader *header = nullptr, FrameStats *stats = nullptr );
+
+  /*!
+   * Like `grabFrame()` but emits float32 temperatures in `unit` for a
+   * THERMAL_FRAME, mapped directly from the drift-compensated counts in the
+   * same pass as the corrections. Unlike the centi-Kelvin output the values
+   * are neither rounded nor clamped. Non-thermal frames hold the extracted raw
+   * counts converted to float.
+   * @param temperatures width*height floats. Can be provided or will be
+   *        allocated with `new float[]` if nullptr. Caller has ownership.
+   * @param size The size of `temperatures` in bytes; see `grabFrame()`.
+   */
+  GrabFrameResult grabFrame( float **temperatures, size_t &size, TemperatureUnit unit,
+                             FrameHeader *header = nullptr );
+
+  /*!
+   * Grab one frame into several representations at once, e.g. corrected
+   * counts for recording next to centi-Kelvin for display. The corrected
+   * outputs are written by the same fused pass; nothing is computed for
+   * outputs left at nullptr. For non-thermal frames every requested output
+   * holds the extracted raw counts.
+   * @returns GrabFrameResult indicating the result of the frame grab.
+   * @throws USBError Could be thrown if an error occurred during frame transfer.
+   */
+  GrabFrameResult grabFrame( const FrameOutputs &outputs, FrameHeader *header = nullptr );
 
   /*!
    * Like `grabFrame()` but stops before the temperature mapping: for a
@@ -75,7 +136,33 @@ public:
    * Non-thermal frames are returned exactly as by `grabFrame()`.
    */
   GrabFrameResult grabRawCountsFrame( unsigned char **image_data, size_t &size,
-                                      FrameHeader *header = nullptr );
+                                      FrameHeader *header = nullptr, FrameStats *stats = nullptr );
+
+  //! Upper bound of grabIntegratedFrame()'s frame count; keeps the 32-bit sums
+  //! from overflowing.
+  static constexpr int kMaxIntegratedFrames = 65536;
+
+  /*!
+   * Integrate the next `frame_count` THERMAL frames into one low-noise frame,
+   * e.g. for radiometric spot checks. The frames are summed as extracted
+   * counts and the corrections and temperature mapping run once on their
+   * average, so the outputs match averaging `frame_count` grabFrame() results
+   * without the per-frame mapping passes. Non-thermal frames are skipped;
+   * a shutter event mid-integration updates the flat-field reference as usual
+   * and each frame is corrected by the reference current when it was taken.
+   * The temporal filter is bypassed and its history left untouched.
+   *
+   * `outputs.raw_counts` receives the averaged counts before corrections
+   * (rebased onto the latest flat-field reference after a shutter event) and
+   * `header` the header of the last integrated frame. Blocks for the duration
+   * of the integration, but the setters are not blocked while a transfer is in
+   * flight. A setter that changes the processing corrections or the window
+   * during the integration restarts it.
+   * @throws std::invalid_argument if `frame_count` is not in [1, kMaxIntegratedFrames].
+   * @throws USBError Could be thrown if an error occurred during frame transfer.
+   */
+  GrabFrameResult grabIntegratedFrame( int frame_count, const FrameOutputs &outputs,
+                                       FrameHeader *header = nullptr );
 
   GrabFrameResult _grabRawFrame( unsigned char **frame_data, size_t &size );
 
@@ -91,8 +178,22 @@ public:
 
   int getFrameHeight() const;
 
+  //! Width of the frames the grab functions return: the processing window's
+  //! if one is set, see setProcessingWindow(), otherwise getFrameWidth(),
+  //! divided by the output binning, see setOutputBinning().
+  int getOutputWidth() const;
+
+  int getOutputHeight() const;
+
+  //! Size in bytes of the 16-bit frames the grab functions return.
+  size_t getOutputFrameSize() const;
+
   Framerate getMaxFramerate() const;
 
+  //! Rate of the thermal frames grabFrame() returns: getMaxFramerate()
+  //! divided by the frame decimation, see setFrameDecimation().
+  Framerate getOutputFramerate() const;
+
   std::string readFirmwareInfo();
 
   std::string readChipID();
@@ -104,20 +205,31 @@ public:
 
   /*!
    * Install a unified CameraCalibration. Replaces any previously installed
-   * sections. Temperature, vignette and dead-pixel sections are each optional.
+   * sections. Temperature, vignette, dead-pixel, non-uniformity and distortion
+   * sections are each optional. The distortion model is compiled into a remap
+   * table; the corrected frames keep the sensor size, and the processing
+   * window and all stages after "distortion" use corrected coordinates.
+   *
+   * The tables are compiled on the calling thread. If no grab is in progress
+   * the calibration is installed before this returns. Otherwise it is handed
+   * to the grabbing thread without waiting, which installs it before it
+   * processes its next frame; a frame already being processed finishes with
+   * the previous calibration.
    *
    * The in-band substrate-drift compensation (see
    * `setDriftCompensationEnabled`) runs on the raw counts regardless of
    * whether a user temperature calibration is installed. Calibrations should
    * therefore be fit against the drift-compensated stream.
    *
-   * @throws std::invalid_argument if vignette or dead-pixel dimensions do not
-   *         match the camera's frame.
+   * @throws std::invalid_argument if vignette, dead-pixel, non-uniformity or
+   *         distortion dimensions do not match the camera's frame.
    */
   void setCalibration( CameraCalibration cal );
 
-  //! Get the currently used CameraCalibration.
-  const CameraCalibration &calibration() const noexcept { return calibration_; }
+  //! Get the currently used CameraCalibration. The snapshot is immutable and
+  //! stays valid when a new calibration is installed. A calibration passed to
+  //! setCalibration() during a grab is returned once it is installed.
+  std::shared_ptr<const CameraCalibration> calibration() const;
 
   /*!
    * Enable or disable host-side one-point flat-field correction using the
@@ -130,6 +242,125 @@ public:
 
   bool isShutterCorrectionEnabled() const { return shutter_correction_enabled_; }
 
+  /*!
+   * Enable (settings given) or disable (nullopt, default) the motion-adaptive
+   * temporal filter on thermal frames. It runs as the last correction, fused
+   * with the temperature mapping, so all outputs of a grab see the same
+   * filtered frame. Its history restarts whenever the corrections change,
+   * in particular on every shutter (ft=1) event, so the flat-field step is
+   * not smeared over the following frames.
+   */
+  void setTemporalFilter( const std::optional<TemporalFilterSettings> &settings );
+
+  const std::optional<TemporalFilterSettings> &temporalFilter() const noexcept
+  {
+    return temporal_filter_;
+  }
+
+  /*!
+   * Enable (settings given) or disable (nullopt, default) the edge-preserving
+   * spatial filter on thermal frames. It runs on the corrected counts after
+   * drift compensation and before the temporal filter.
+   * @throws std::invalid_argument if the radius is not 1 or 2 or a sigma is
+   *         not finite.
+   */
+  void setSpatialFilter( const std::optional<SpatialFilterSettings> &settings );
+
+  const std::optional<SpatialFilterSettings> &spatialFilter() const noexcept
+  {
+    return spatial_filter_;
+  }
+
+  /*!
+   * Insert a user stage into the thermal processing chain in front of the
+   * stage named `before`, or at the end if `before` is empty. The built-in
+   * stages are, in order: flat_field, dead_pixels, vignette, non_uniformity,
+   * drift, spatial_filter, distortion, temporal_filter and temperature. In front of
+   * "temperature" (the default) the stage sees the corrected counts and its
+   * result reaches every output of the grab; after it, it sees the main
+   * output (centi-Kelvin if requested). The chain runs in row bands together
+   * with the built-in stages; see ProcessingStage. Stages are invoked from
+   * the grabbing thread.
+   * @throws std::invalid_argument if `stage` is null or already added, or if
+   *         no stage is named `before`.
+   */
+  void addProcessingStage( ProcessingStage::SharedPtr stage,
+                           const std::string &before = "temperature" );
+
+  //! Remove a stage added with addProcessingStage(). Returns false if it was
+  //! not in the chain.
+  bool removeProcessingStage( const ProcessingStage::SharedPtr &stage );
+
+  //! The processing chain, built-in stages included, in execution order.
+  std::vector<ProcessingStage::SharedPtr> processingStages() const;
+
+  /*!
+   * Frame, drop and transfer error counters, the frame rate, and latency
+   * percentiles of the USB transfer, the processing of a grab and each entry
+   * of the processing chain (fused built-in stages share one entry). Always
+   * recorded; may be called from any thread. See writePrometheusText().
+   */
+  MetricsSnapshot metricsSnapshot() const { return metrics_.snapshot(); }
+
+  //! Restart all counters and histograms of metricsSnapshot().
+  void resetMetrics() { metrics_.reset(); }
+
+  /*!
+   * Restrict processing to `window` (clipped to the frame), or process the
+   * full frame again (nullopt, default). Only the window and a halo around
+   * it, one pixel for the dead-pixel inpaint plus the spatial filter radius,
+   * are extracted and corrected; the grab functions return window-sized
+   * frames (getOutputWidth() x getOutputHeight()) and the processing stages
+   * see the window with its halo, at the origin given in StageRows. The
+   * built-in analysis stages report sensor coordinates either way. The drift
+   * signal and the flat-field
+   * reference are still computed from the full transfers.
+   *
+   * Sentinel positions are not learned while a window is set. A grab waiting
+   * for its transfer returns BUFFER_TOO_SMALL if this changes the output size.
+   * @throws std::invalid_argument if `window` does not overlap the frame.
+   */
+  void setProcessingWindow( const std::optional<RegionOfInterest> &window );
+
+  const std::optional<RegionOfInterest> &processingWindow() const noexcept
+  {
+    return processing_window_;
+  }
+
+  /*!
+   * Return the mean of each `factor` x `factor` block of the output window
+   * (1, default: no binning, 2 or 4), e.g. 160x120 frames of a 320x240
+   * sensor for 2. The blocks are averaged into every requested output as the
+   * bands of the processing chain complete, so the grabs cost hardly more
+   * than unbinned ones and callers handle a fraction of the data. Integer
+   * outputs are rounded; rows and columns that do not fill a block are
+   * dropped. The processing stages still see the full-resolution frame. A
+   * grab waiting for its transfer returns BUFFER_TOO_SMALL if this changes
+   * the output size.
+   * @throws std::invalid_argument if `factor` is not 1, 2 or 4, or if the
+   *         processing window is smaller than `factor`.
+   */
+  void setOutputBinning( int factor );
+
+  int outputBinning() const noexcept { return output_binning_; }
+
+  /*!
+   * Return only every `factor`-th thermal frame (1, default: every frame).
+   * The thermal frames in between are transferred, since the camera streams
+   * at a fixed rate, but dropped before extraction and processing; shutter
+   * frames still refresh the flat-field reference, and other frames are
+   * returned as before. The setters are not blocked by the dropped frames.
+   * grabIntegratedFrame() is not decimated.
+   * @throws std::invalid_argument if `factor` is less than 1.
+   */
+  void setFrameDecimation( int factor );
+
+  int frameDecimation() const noexcept { return frame_decimation_; }
+
+  //! Rows per band of the processing chain; 0 (default) picks the band height
+  //! from the frame width.
+  void setProcessingBandRows( int rows );
+
   //! Raw mean of the most recent shutter (ft=1) frame, in sensor counts.
   //! Returns 0 before the first shutter event.
   double getLastShutterMean() const noexcept { return last_shutter_mean_; }
@@ -170,6 +401,22 @@ public:
 
   bool isDriftCompensationEnabled() const noexcept { return drift_compensation_enabled_; }
 
+  /*!
+   * Enable / disable the column fixed-pattern correction. Column offsets drift
+   * between shutter events and show up as vertical striping. Header row 2 of
+   * the Compact Pro / Nano 300 transfers is a per-column dark reference; its
+   * change per column since the last shutter (ft=1) event, smoothed over a
+   * few frames and with its mean removed (global drift is left to the drift
+   * compensation), is subtracted from each column during extraction.
+   *
+   * The reference is re-taken from the first thermal frame after every
+   * shutter event. No effect on the Compact, which has no such row.
+   * Defaults to OFF.
+   */
+  void setColumnCorrectionEnabled( bool enabled );
+
+  bool isColumnCorrectionEnabled() const noexcept { return column_correction_enabled_; }
+
   //! Per-product substrate-drift slope `K_pad` (scene-raw counts per
   //! pad-column count). 0 disables the intra-session drift term.
   double getDriftCompensationCoefficient() const noexcept { return substrate_drift_coefficient_; }
@@ -211,7 +458,168 @@ protected:
   std::string serial_number_;
 
 private:
-  void extractFrame( const unsigned char *data, unsigned char *frame_data );
+  /*!
+   * Geometry and hot-loop kernels of one camera model, instantiated from
+   * DeviceTraits so the per-frame loops run with compile-time bounds and
+   * strides. Selected once in the constructor; empty for unsupported types.
+   */
+  struct FrameKernels {
+    int width = 0;
+    int height = 0;
+    int frame_header_size = 0;
+    int transfer_total_size = 0;
+    int transfer_request_size = 0;
+    uint32_t transfer_device_request_size = 0;
+    size_t min_header_size = 0;
+    int row_stride = 0; //!< Padded row length of the transfer body in pixels.
+    //! Byte offset of the per-column dark-reference row in a transfer, -1 if
+    //! the model has none.
+    int column_reference_offset = -1;
+
+    size_t ( *extract )( SentinelMap &map, const unsigned char *data, unsigned char *frame,
+                         bool learn, const int32_t *column_offset ) = nullptr;
+    double ( *pad_drift_signal )( const unsigned char *transfer_buffer,
+                                  size_t transfer_buffer_size ) = nullptr;
+  };
+
+  static FrameKernels selectFrameKernels( SeekDevice::Type type ) noexcept;
+
+  //! Shared implementation of the grab variants. Grabs and processes one
+  //! transfer into the requested outputs; with none requested only the header
+  //! and the shutter reference are updated.
+  GrabFrameResult grabProcessedFrame( const FrameOutputs &outputs, FrameHeader *header );
+
+  //! Bodies of grabProcessedFrame() and grabIntegratedFrame(), called with
+  //! `device_mutex_` and `buffer_lock` held.
+  GrabFrameResult grabProcessedFrameLocked( std::unique_lock<std::mutex> &buffer_lock,
+                                            const FrameOutputs &outputs, FrameHeader *header );
+  GrabFrameResult grabIntegratedFrameLocked( std::unique_lock<std::mutex> &buffer_lock,
+                                             int frame_count, const FrameOutputs &outputs,
+                                             FrameHeader *header );
+
+  //! grabProcessedFrame() into `*data`, allocated if null, as the output
+  //! `output` of `outputs`. The size is checked under the grab's lock.
+  template<typename T, typename Output>
+  GrabFrameResult grabIntoBuffer( T **data, size_t &size, Output *FrameOutputs::*output,
+                                  FrameOutputs outputs, FrameHeader *header );
+
+  //! Run `grab` under `buffer_mutex_` with the grab marked as in progress for
+  //! setCalibration(), installing calibrations set before and during it.
+  template<typename Grab>
+  GrabFrameResult runGrab( Grab &&grab );
+
+  //! Grab one transfer into `buffer_` and parse its header. Shutter frames
+  //! refresh the flat-field reference (and the automatic c0) right here.
+  //! `buffer_lock`, if given, is released while the transfer is in flight.
+  GrabFrameResult grabTransfer( FrameHeader &header, size_t &buffer_size,
+                                std::unique_lock<std::mutex> *buffer_lock = nullptr );
+
+  //! Buffer the pipeline finishes in for `outputs`: centi-Kelvin, counts or
+  //! `frame_scratch_`.
+  uint16_t *pipelineFrame( const FrameOutputs &outputs );
+
+  //! Pixels of the region the pipeline processes: the frame, or the
+  //! processing window with its halo.
+  size_t processingPixelCount() const noexcept
+  {
+    return static_cast<size_t>( pipeline_.width() ) * pipeline_.height();
+  }
+
+  //! Flat-field offsets of the processed region.
+  const int32_t *shutterOffset() const noexcept
+  {
+    return processing_window_ ? window_shutter_offset_.data() : shutter_offset_.data();
+  }
+
+  //! Whether the processed region differs from the returned frames, i.e. a
+  //! processing window or binning is set.
+  bool reducesOutputs() const noexcept { return processing_window_ || output_binning_ > 1; }
+
+  //! Processing window, or the whole frame without one.
+  RegionOfInterest outputWindow() const noexcept;
+
+  //! getOutputWidth() etc. for callers holding `buffer_mutex_`.
+  int outputWidth() const noexcept { return outputWindow().width / output_binning_; }
+
+  int outputHeight() const noexcept { return outputWindow().height / output_binning_; }
+
+  size_t outputPixelCount() const noexcept
+  {
+    return static_cast<size_t>( outputWidth() ) * outputHeight();
+  }
+
+  //! Region-sized internal buffers for the outputs requested in `outputs`,
+  //! for processing with reducesOutputs(). Statistics are not requested.
+  FrameOutputs regionOutputs( const FrameOutputs &outputs );
+
+  /*!
+   * Crop the output window out of rows [row_begin, row_end) of the
+   * region-sized `region_outputs`, bin it into `outputs` and add it to
+   * `outputs.stats`, reduced from `stats_frame`, except for its sentinel
+   * count. Rows must be passed in order; row 0 starts a new frame.
+   */
+  void reduceOutputRows( const FrameOutputs &region_outputs, const uint16_t *stats_frame,
+                         const FrameOutputs &outputs, int row_begin, int row_end );
+
+  //! Run `stages` (narrowed to the requested outputs) of the thermal pipeline
+  //! from the extracted `source` into `frame` and the other outputs, filling
+  //! `outputs.stats` except for its sentinel count. With reducesOutputs(),
+  //! `outputs` are region-sized and reduced into `reduced_outputs`.
+  void processThermalFrame( const FrameHeader &header, unsigned stages, const uint16_t *source,
+                            uint16_t *frame, int32_t drift_offset, const FrameOutputs &outputs,
+                            const FrameOutputs &reduced_outputs );
+
+  //! Substrate-drift offset in counts for the transfer in `buffer_`.
+  int32_t computeDriftOffset( size_t transfer_buffer_size ) const;
+
+  //! Install the calibration set by setCalibration(), if any. Called under
+  //! `buffer_mutex_`.
+  void installPendingCalibration();
+
+  //! Mark a grab, or the startup sequence of open(), as in progress. Only set
+  //! under `buffer_mutex_`.
+  void setGrabbing( bool grabbing );
+
+  //! Replace the calibration returned by calibration(). Called under
+  //! `buffer_mutex_` or by the grabbing thread.
+  void publishCalibration( std::shared_ptr<const CameraCalibration> calibration );
+
+  //! publishCalibration() with the temperature section replaced.
+  void publishTemperature( const TemperatureCalibration &temperature );
+
+  //! Recompute `pipeline_stages_` from the current configuration and session
+  //! state. Must be called (under `buffer_mutex_` once streaming) whenever
+  //! either changes.
+  void selectPipelineStages();
+
+  //! selectPipelineStages() after a setter changed the configuration; also
+  //! tells a running grabIntegratedFrame() to restart.
+  void configurationChanged();
+
+  //! Extract the visible image from a transfer body into host-endian pixels,
+  //! inpainting 0 / 0xFFFF sentinels via `sentinel_map_`. `learn` selects
+  //! whether the frame may update the learned sentinel positions;
+  //! `column_offset` (see updateColumnOffsets()) is subtracted in the same pass.
+  //! Returns the number of sentinel pixels.
+  size_t extractFrame( const unsigned char *data, unsigned char *frame_data, bool learn = true,
+                       const int32_t *column_offset = nullptr );
+
+  //! extractFrame() restricted to the processed region, see processingPixelCount().
+  size_t extractProcessingRegion( const unsigned char *data, uint16_t *frame, bool learn,
+                                  const int32_t *column_offset );
+
+  //! Halo around the processing window the enabled stages need.
+  int processingWindowHalo() const noexcept;
+
+  //! Point the pipeline at the processing window with its halo and cut the
+  //! flat-field offsets to it.
+  void updateProcessingRegion();
+
+  //! Update the column fixed-pattern estimate from the dark-reference row of
+  //! the thermal transfer in `buffer_` and return the per-column offsets to
+  //! subtract, or nullptr if the correction is disabled, unsupported or just
+  //! (re-)seeded its reference.
+  const int32_t *updateColumnOffsets( size_t transfer_buffer_size );
 
   //! Sentinel-excluded mean of the first pad column (`x = getFrameWidth()`)
   //! across the visible rows of a raw transfer buffer. Returns 0.0 if the
@@ -237,16 +645,75 @@ private:
   bool tryConsumeStartupFrames();
 
   SeekDevice device_;
+  FrameKernels kernels_;
+  MetricsRegistry metrics_;
+  //! Thermal correction pipeline with the compiled calibration tables.
+  FramePipeline pipeline_;
+  //! Built-in and user stages of the thermal chain; runs `pipeline_`.
+  ProcessingPipeline processing_;
+  //! FramePipeline::Stage set selected for the current configuration,
+  //! including kTemperature if a temperature mapping is installed.
+  unsigned pipeline_stages_ = 0;
   std::recursive_mutex device_mutex_;
-  std::mutex buffer_mutex_;
+  mutable std::mutex buffer_mutex_;
   std::vector<unsigned char> buffer_;
+  FrameStatsAccumulator stats_accumulator_;
+  //! Working frame for grabs that request neither counts nor centi-Kelvin.
+  std::vector<uint16_t> frame_scratch_;
+  //! Processing window in frame coordinates and its flat-field offsets.
+  std::optional<RegionOfInterest> processing_window_;
+  std::vector<int32_t> window_shutter_offset_;
+  //! Output binning factor and the region-sized outputs reduced to the output
+  //! size during processing, see reduceOutputRows(), with the output rows
+  //! reduced so far and a reduced row for the statistics.
+  int output_binning_ = 1;
+  std::vector<uint16_t> region_raw_counts_;
+  std::vector<uint16_t> region_counts_;
+  std::vector<uint16_t> region_centi_kelvin_;
+  std::vector<float> region_temperature_;
+  int reduced_rows_ = 0;
+  std::vector<uint16_t> reduced_row_;
+  //! Thermal frames returned per frame transferred, and the frames still to
+  //! drop before the next one is returned.
+  int frame_decimation_ = 1;
+  int decimation_phase_ = 0;
+  //! Incremented by configurationChanged(), so grabIntegratedFrame() notices
+  //! setter calls made while it released `buffer_mutex_`.
+  uint64_t configuration_generation_ = 0;
+  //! grabIntegratedFrame() sums and the flat-field reference they are relative to.
+  std::vector<uint32_t> integration_sum_;
+  std::vector<int32_t> integration_reference_;
   //! Per-pixel additive shutter offset `mean(ft1) - ft1[i]`, computed from
   //! the latest shutter frame (dead-pixel sentinels excluded from the mean).
   //! Applied as `corrected[i] = raw[i] + shutter_offset_[i]`. Empty until the
   //! first shutter frame has been seen.
   std::vector<int32_t> shutter_offset_;
+  //! Temporal filter settings and per-pixel history (Q6 counts). The history
+  //! is re-seeded from the next thermal frame when `temporal_reset_` is set.
+  std::optional<TemporalFilterSettings> temporal_filter_;
+  std::vector<int32_t> temporal_history_;
+  bool temporal_reset_ = true;
+  std::optional<SpatialFilterSettings> spatial_filter_;
+  //! Learned sentinel positions merged with the calibrated dead pixels. Sized
+  //! and re-seeded in open().
+  SentinelMap sentinel_map_;
   double last_shutter_mean_ = 0.0;
-  CameraCalibration calibration_;
+  //! Guards `grabbing_`, `pending_calibration_` and replacing `calibration_`.
+  //! Never held for longer than a pointer swap.
+  mutable std::mutex calibration_mutex_;
+  //! Active calibration. Replaced as a whole, never modified, so calibration()
+  //! can hand it out. Read without `calibration_mutex_` by the thread that
+  //! replaces it.
+  std::shared_ptr<const CameraCalibration> calibration_ =
+      std::make_shared<const CameraCalibration>();
+  //! A calibration and its compiled tables set by setCalibration() during a
+  //! grab and not installed yet.
+  struct PendingCalibration {
+    CameraCalibration calibration;
+    std::shared_ptr<const FramePipeline::CompiledCalibration> compiled;
+  };
+  std::shared_ptr<PendingCalibration> pending_calibration_;
+  bool grabbing_ = false;
   libusb_context *usb_context_ = nullptr;
   libusb_device_handle *usb_device_handle_ = nullptr;
   bool shutter_correction_enabled_ = true;
@@ -257,6 +724,13 @@ private:
   //! boot's live substrate state; cleared on close().
   //! Toggling `drift_compensation_enabled_` does not touch the anchor.
   bool drift_compensation_enabled_ = true;
+  //! Column fixed-pattern correction state: dark-reference row after the last
+  //! shutter event, smoothed per-column change since then (Q8) and the
+  //! zero-mean offsets handed to the extraction. Cleared on every shutter event.
+  bool column_correction_enabled_ = false;
+  std::vector<int32_t> column_reference_;
+  std::vector<int32_t> column_drift_;
+  std::vector<int32_t> column_offset_;
   bool drift_anchor_set_ = false;
   double drift_reference_anchor_ = 0.0;
 
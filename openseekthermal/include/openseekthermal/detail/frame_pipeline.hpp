@@ -0,0 +1,301 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_FRAME_PIPELINE_HPP
+#define OPENSEEKTHERMAL_FRAME_PIPELINE_HPP
+
+#include "../camera_calibration.hpp"
+#include "../processing_stage.hpp"
+#include "../roi_statistics.hpp"
+#include "../temporal_filter.hpp"
+#include "./bilateral_filter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace openseekthermal
+{
+
+/*!
+ * Thermal-frame correction pipeline from an extracted host-endian frame to
+ * the requested outputs:
+ *
+ *   flat-field → dead-pixel inpaint → vignette → non-uniformity → drift
+ *     → spatial filter → distortion → temporal filter → temperature
+ *
+ * The temporal filter runs on the counts right before the (affine)
+ * temperature mapping, in the same pass, so filtering there is equivalent to
+ * filtering the temperatures and every output of a grab sees the same
+ * filtered frame. The distortion correction resamples the frame after the
+ * corrections that are modelled in sensor coordinates.
+ *
+ * The main output receives the corrected counts, or centi-Kelvin with
+ * kTemperature. kCounts additionally stores the corrected counts next to the
+ * centi-Kelvin frame and kTemperatureFloat writes float32 Kelvin / Celsius,
+ * all from the same pass. The source may alias the main output.
+ *
+ * The stages are exposed as ProcessingStage objects (builtinStages()) run by
+ * a ProcessingPipeline, which fuses adjacent point-wise stages through
+ * fusedPointStage(). Every subset of the point-wise stages has its own
+ * instantiation of the fused kernel, so the enabled stages run as tight
+ * per-pixel loops with neither per-pixel branches on the configuration nor
+ * passes for disabled stages. Only the sparse dead-pixel inpaint, the spatial
+ * filter, the distortion correction and user stages, which need finished
+ * neighbours or a specific domain, split the point-wise stages into more than
+ * one pass.
+ *
+ * Per-pixel corrections are precompiled into an immutable
+ * CompiledCalibration (compile()): the vignette polynomial becomes a Q8
+ * fixed-point offset table (the Q12 non-uniformity gain and offset tables are
+ * used as they are), the distortion model a remap table of source indices
+ * and Q8 bilinear weights, and the temperature mapping a 64k entry lookup
+ * table matching TemperatureCalibration::apply() exactly. The float mapping
+ * is a single multiply-add on the corrected counts. Compiling is independent
+ * of the pipeline, so a new calibration can be built on another thread while
+ * frames are processed and swapped in between frames with setCalibration().
+ *
+ * The pipeline can be restricted to a region of the frame (setRegion()), in
+ * which case every buffer it reads or writes is region-sized and the
+ * per-pixel tables are cut to the region.
+ */
+class FramePipeline
+{
+public:
+  enum Stage : unsigned {
+    kFlatField = 1u << 0,
+    kDeadPixels = 1u << 1,
+    kVignette = 1u << 2,
+    kDrift = 1u << 3,
+    kTemperature = 1u << 4,
+    kTemperatureFloat = 1u << 5,
+    kCounts = 1u << 6,
+    kTemporalFilter = 1u << 7,
+    kSpatialFilter = 1u << 8,
+    kDistortion = 1u << 9,
+    kNonUniformity = 1u << 10,
+  };
+  static constexpr unsigned kStageCount = 11;
+  static constexpr unsigned kAllStages = ( 1u << kStageCount ) - 1;
+
+  //! Inputs that change every frame or every shutter cycle.
+  struct FrameInputs {
+    const int32_t *shutter_offset = nullptr; //!< Per-pixel offset for kFlatField.
+    int32_t drift_offset = 0;                //!< Counts subtracted by kDrift.
+    //! Per-pixel state of kTemporalFilter (Q6 counts), owned by the caller.
+    int32_t *temporal_history = nullptr;
+    //! Restart kTemporalFilter from this frame, e.g. after a shutter event.
+    bool temporal_reset = false;
+  };
+
+  //! width*height output buffers. Only `frame` is required.
+  struct FrameOutputs {
+    uint16_t *frame = nullptr;    //!< Counts, or centi-Kelvin with kTemperature.
+    uint16_t *counts = nullptr;   //!< Corrected counts for kCounts.
+    float *temperature = nullptr; //!< Output of kTemperatureFloat.
+    TemperatureUnit temperature_unit = TemperatureUnit::Celsius;
+  };
+
+  //! Bilinear remap of a frame or region: index of the top-left of the four
+  //! source pixels and the Q8 weights of the right and lower ones per pixel.
+  struct RemapTable {
+    std::vector<int32_t> index;
+    std::vector<uint16_t> weight_x;
+    std::vector<uint16_t> weight_y;
+    //! Source rows read above or below an output row.
+    int halo = 0;
+  };
+
+  struct DistortionTable {
+    //! Q8 sensor position (x, y interleaved) each pixel of the corrected
+    //! frame is sampled from, clamped to the frame.
+    std::vector<int32_t> source;
+    //! See distortionRadius().
+    int radius = 0;
+    //! Remap table of the full frame.
+    RemapTable remap;
+  };
+
+  struct TemperatureTable {
+    //! Raw count → clamped centi-Kelvin.
+    std::vector<uint16_t> lut;
+    float c0 = 0.0f;
+    float c1 = 1.0f;
+  };
+
+  /*!
+   * The per-pixel tables of a CameraCalibration, compiled for the full
+   * frame. Immutable once built; the components are shared, so calibrations
+   * that differ in one correction share the tables of the others.
+   */
+  struct CompiledCalibration {
+    //! The Stage bits of the corrections present.
+    unsigned stages = 0;
+    std::shared_ptr<const DeadPixelMask> dead_pixels;
+    //! Q8 fixed-point `mean_model - model(x, y)` per pixel, shared with a
+    //! precompiled VignetteCorrection::offsets.
+    std::shared_ptr<const int32_t> vignette_offset;
+    std::shared_ptr<const NonUniformityCorrection> non_uniformity;
+    std::shared_ptr<const DistortionTable> distortion;
+    std::shared_ptr<const TemperatureTable> temperature;
+  };
+
+  /*!
+   * Compile the sections of `calibration` for a width x height frame. Does
+   * not touch any pipeline and may run on any thread.
+   * @throws std::invalid_argument if a section does not match the frame size.
+   */
+  static std::shared_ptr<const CompiledCalibration>
+  compile( const CameraCalibration &calibration, int width, int height );
+
+  //! Compile `temperature` into its lookup table.
+  static std::shared_ptr<const TemperatureTable>
+  compileTemperature( const TemperatureCalibration &temperature );
+
+  //! Number of fusedPointStage() slots; enough for every point-wise stage.
+  static constexpr size_t kFusedStageSlots = 6;
+
+  FramePipeline() : FramePipeline( 0, 0 ) { }
+
+  FramePipeline( int width, int height );
+
+  //! The built-in stages reference the pipeline.
+  FramePipeline( const FramePipeline & ) = delete;
+  FramePipeline &operator=( const FramePipeline & ) = delete;
+
+  //! Width of the processed frames: the region's, see setRegion().
+  int width() const noexcept { return width_; }
+
+  int height() const noexcept { return height_; }
+
+  /*!
+   * Process only `region` of the frame, clipped to it; an empty region
+   * restores the full frame. width() and height() become the region's, and
+   * the frames, FrameInputs and FrameOutputs of the following runs must be
+   * region-sized. The calibration tables are cut to the region, so the
+   * calibration does not have to be set again.
+   */
+  void setRegion( const RegionOfInterest &region );
+
+  //! The processed region in frame coordinates; the full frame by default.
+  const RegionOfInterest &region() const noexcept { return region_; }
+
+  /*!
+   * Use `calibration`, compiled for this pipeline's frame size, from the next
+   * frame on; nullptr disables the calibrated stages. Only the cuts of the
+   * tables to the region are made here, none for the full frame.
+   */
+  void setCalibration( std::shared_ptr<const CompiledCalibration> calibration );
+
+  //! The calibration in use; never null.
+  const std::shared_ptr<const CompiledCalibration> &calibration() const noexcept
+  {
+    return calibration_;
+  }
+
+  //! Replace the temperature mapping of the calibration in use; the other
+  //! tables are kept. nullptr disables the temperature stages.
+  void setTemperature( std::shared_ptr<const TemperatureTable> temperature );
+
+  //! Compile `temperature` and use it, see above.
+  void setTemperature( const TemperatureCalibration *temperature );
+
+  //! Largest distance in pixels, rounded up, between a pixel of the
+  //! distortion-corrected frame and the sensor pixels it is interpolated
+  //! from; 0 without distortion correction.
+  int distortionRadius() const noexcept
+  {
+    return calibration_->distortion ? calibration_->distortion->radius : 0;
+  }
+
+  //! Configure kTemporalFilter. nullptr disables the stage.
+  void setTemporalFilter( const TemporalFilterSettings *settings );
+
+  //! Precompute the kSpatialFilter weight tables. nullptr disables the stage.
+  void setSpatialFilter( const SpatialFilterSettings *settings );
+
+  //! Stages whose calibration data is present. kFlatField, kDrift and kCounts
+  //! depend only on the per-frame arguments and are always reported.
+  unsigned availableStages() const noexcept;
+
+  /*!
+   * Select `stages` (restricted to availableStages() and the provided
+   * outputs) and the per-frame data for the next run of the built-in stages.
+   * The pointers must stay valid until the frame is processed.
+   */
+  void prepare( unsigned stages, const FrameInputs &inputs, const FrameOutputs &outputs );
+
+  //! Stages selected by the last prepare().
+  unsigned activeStages() const noexcept { return active_; }
+
+  /*!
+   * The built-in stages in pipeline order, named "flat_field", "dead_pixels",
+   * "vignette", "non_uniformity", "drift", "spatial_filter", "distortion",
+   * "temporal_filter" and "temperature" (which also writes kCounts and kTemperatureFloat). Each is
+   * enabled while one of its Stage bits is active and writes
+   * FrameOutputs::frame (counts or centi-Kelvin); the extra outputs are
+   * written directly by the temperature stage.
+   */
+  const std::vector<ProcessingStage::SharedPtr> &builtinStages() const noexcept
+  {
+    return builtin_stages_;
+  }
+
+  //! Stage bits of `stage` if it is a point-wise built-in stage, 0 otherwise.
+  unsigned pointStages( const ProcessingStage *stage ) const noexcept;
+
+  //! A stage running the point-wise `stages` as one fused pass. Each slot
+  //! (< kFusedStageSlots) is reconfigured by every call.
+  ProcessingStage *fusedPointStage( size_t slot, unsigned stages );
+
+private:
+  class BuiltinStage;
+  class FusedPointStage;
+
+  //! Cut the tables of calibration_ to region_.
+  void updateRegionTables();
+
+  //! Interpolate rows [row_begin, row_end) of the distortion-corrected frame.
+  void remapRows( const uint16_t *input, uint16_t *output, int row_begin, int row_end ) const;
+
+  //! The fused point-wise kernel for `stages` on rows [row_begin, row_end).
+  void runPointRows( unsigned stages, const uint16_t *input, uint16_t *output, int row_begin,
+                     int row_end ) const;
+
+  int frame_width_ = 0;
+  int frame_height_ = 0;
+  RegionOfInterest region_;
+  int width_ = 0;
+  int height_ = 0;
+  //! Stages that do not depend on calibration_.
+  unsigned available_ = kFlatField | kDrift | kCounts;
+  unsigned active_ = 0;
+  FrameInputs inputs_;
+  FrameOutputs outputs_;
+  std::vector<ProcessingStage::SharedPtr> builtin_stages_;
+  std::vector<ProcessingStage::SharedPtr> fused_stages_;
+  std::shared_ptr<const CompiledCalibration> calibration_;
+  //! The tables in use: those of calibration_ or their cuts to the region
+  //! in the `region_` members.
+  const DeadPixelMask *dead_pixels_ = nullptr;
+  DeadPixelMask region_dead_pixels_;
+  const int32_t *vignette_offset_ = nullptr;
+  std::vector<int32_t> region_vignette_offset_;
+  const int32_t *nuc_gain_ = nullptr;
+  const int32_t *nuc_offset_ = nullptr;
+  std::vector<int32_t> region_nuc_gain_;
+  std::vector<int32_t> region_nuc_offset_;
+  const RemapTable *remap_ = nullptr;
+  RemapTable region_remap_;
+  BilateralFilter spatial_filter_;
+  //! kTemporalFilter blend factor ramp, Q8.
+  int32_t temporal_alpha_min_ = 256;
+  int32_t temporal_slope_ = 0;
+  int32_t temporal_noise_threshold_ = 0;
+  int32_t temporal_motion_threshold_ = 0;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_FRAME_PIPELINE_HPP
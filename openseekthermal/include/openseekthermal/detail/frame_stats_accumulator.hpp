@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_FRAME_STATS_ACCUMULATOR_HPP
+#define OPENSEEKTHERMAL_FRAME_STATS_ACCUMULATOR_HPP
+
+#include "../frame_stats.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace openseekthermal
+{
+
+/*!
+ * Builds FrameStats from the rows of a frame in any number of add() calls,
+ * so the processing chain can feed each band right after producing it.
+ */
+class FrameStatsAccumulator
+{
+public:
+  void reset() noexcept;
+
+  void add( const uint16_t *pixels, size_t count ) noexcept;
+
+  //! Write the statistics of the pixels added since reset() into `stats`.
+  //! The sentinel count is left untouched.
+  void finish( FrameStats &stats ) const noexcept;
+
+private:
+  //! Interleaved histograms so consecutive equal bins do not serialize on
+  //! one counter; summed in finish().
+  static constexpr int kLanes = 4;
+
+  std::array<std::array<uint32_t, FrameStats::kHistogramBins>, kLanes> histogram_{};
+  uint64_t sum_ = 0;
+  size_t count_ = 0;
+  uint16_t min_ = 0xFFFF;
+  uint16_t max_ = 0;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_FRAME_STATS_ACCUMULATOR_HPP
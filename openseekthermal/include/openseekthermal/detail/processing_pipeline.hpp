@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_PROCESSING_PIPELINE_HPP
+#define OPENSEEKTHERMAL_PROCESSING_PIPELINE_HPP
+
+#include "../metrics.hpp"
+#include "../processing_stage.hpp"
+#include "./frame_pipeline.hpp"
+#include "./frame_stats_accumulator.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace openseekthermal
+{
+
+/*!
+ * Ordered chain of ProcessingStage objects, the built-in stages of a
+ * FramePipeline plus user stages, executed in row bands.
+ *
+ * Rather than streaming the whole frame through memory once per stage, the
+ * executor advances every stage by about one band (bandRows()) at a time as
+ * a wavefront: each stage runs up to the last row whose input is complete,
+ * lagging its predecessor by the halo the two need. A band of all buffers
+ * thus stays in L1/L2 from the first stage to the last. Adjacent point-wise
+ * built-in stages are fused into one pass.
+ *
+ * Stages run in place on the output frame where they can; out-of-place
+ * stages ping-pong with a scratch frame. The wall time of each entry per
+ * frame is recorded in the stage histograms of a MetricsRegistry.
+ */
+class ProcessingPipeline
+{
+public:
+  //! The built-in stages of `builtins` form the initial chain. `builtins`
+  //! and `metrics` must outlive the pipeline.
+  ProcessingPipeline( FramePipeline &builtins, MetricsRegistry &metrics );
+
+  ProcessingPipeline( const ProcessingPipeline & ) = delete;
+  ProcessingPipeline &operator=( const ProcessingPipeline & ) = delete;
+
+  /*!
+   * Insert `stage` in front of the stage named `before`, or at the end if
+   * `before` is empty.
+   * @throws std::invalid_argument if `stage` is null or already in the chain,
+   *         or if no stage is named `before`.
+   */
+  void insertStage( ProcessingStage::SharedPtr stage, const std::string &before );
+
+  /*!
+   * Remove a stage added with insertStage(). Returns false if it is not in
+   * the chain.
+   * @throws std::invalid_argument if `stage` is a built-in stage.
+   */
+  bool removeStage( const ProcessingStage *stage );
+
+  const std::vector<ProcessingStage::SharedPtr> &stages() const noexcept { return stages_; }
+
+  //! Rows per band; 0 (default) picks about 16 KiB of frame data per band.
+  void setBandRows( int rows ) noexcept { band_rows_ = rows < 0 ? 0 : rows; }
+
+  int bandRows() const noexcept { return band_rows_; }
+
+  //! Invoked with rows [row_begin, row_end) once they are final in `frame`
+  //! and in every output the built-in stages write.
+  using BandCallback = std::function<void( int row_begin, int row_end )>;
+
+  /*!
+   * Run the enabled stages on the width*height frame `source` (which is
+   * never written) into `frame`. The built-in stages must have been
+   * prepared for this frame; see FramePipeline::prepare(). If `stats` is set,
+   * each band of the final output is added to it right after it is produced,
+   * and `on_band` is invoked for it after that, in row order, so consumers of
+   * the result can process it while it is still in cache.
+   */
+  void run( const FrameHeader &header, const uint16_t *source, uint16_t *frame,
+            FrameStatsAccumulator *stats = nullptr, const BandCallback &on_band = {} );
+
+private:
+  struct Step {
+    ProcessingStage *stage;
+    const uint16_t *input;
+    uint16_t *output;
+    int halo;
+    int done;
+    std::chrono::nanoseconds time;
+    LatencyHistogram *latency;
+    const char *trace_name;
+  };
+
+  struct StageMetrics {
+    std::string name;
+    LatencyHistogram *latency;
+    //! Interned name of the trace events, null without tracing.
+    const char *trace_name;
+  };
+
+  //! Fill `plan_` with the enabled stages, fusing adjacent point-wise built-ins.
+  void plan();
+
+  //! Metrics of the entry `name`; cached since the registry lookup locks.
+  const StageMetrics &stageMetrics( const char *name );
+
+  FramePipeline &builtins_;
+  std::vector<ProcessingStage::SharedPtr> stages_;
+  std::vector<Step> plan_;
+  std::vector<uint16_t> scratch_;
+  MetricsRegistry &metrics_;
+  std::vector<StageMetrics> stage_metrics_;
+  int band_rows_ = 0;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_PROCESSING_PIPELINE_HPP
@@ -0,0 +1,172 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_SENTINEL_MAP_HPP
+#define OPENSEEKTHERMAL_SENTINEL_MAP_HPP
+
+#include "../dead_pixel_mask.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <endian.h>
+#include <vector>
+
+namespace openseekthermal
+{
+
+/*!
+ * Online-learned set of pixel positions that read the 0x0000 / 0xFFFF
+ * sentinel on the wire, merged with the calibrated dead-pixel positions.
+ *
+ * The sentinels sit at nearly fixed positions, so instead of testing every
+ * pixel of every frame, extraction copies the padded transfer blindly and only
+ * revisits the known positions. A branch-free sentinel count taken during the
+ * copy verifies each frame: if it exceeds the number of sentinels found at the
+ * known positions, a full scan inpaints the stragglers and feeds the learner.
+ *
+ * Learning uses hysteresis on a per-pixel score so rare flickers do not churn
+ * the list: a sentinel hit adds kHitGain, candidates are promoted at
+ * kPromoteScore and their score halves every kDecayInterval frames, known
+ * entries lose one point per valid frame and are evicted at zero. Calibrated
+ * dead pixels are seeded as permanent entries.
+ *
+ * The known list is stored as structure-of-arrays so the per-frame fix loop
+ * streams through a few compact arrays.
+ */
+class SentinelMap
+{
+public:
+  static constexpr uint8_t kHitGain = 16;
+  static constexpr uint8_t kPromoteScore = 48;
+  static constexpr uint32_t kDecayInterval = 64;
+
+  SentinelMap() = default;
+
+  /*!
+   * Drop all learned state and size the map for a `width` x `height` image
+   * whose rows are `row_step` uint16 apart in the transfer body.
+   */
+  void reset( int width, int height, int row_step );
+
+  /*!
+   * Seed the known list with the positions of a calibrated dead-pixel mask.
+   * Seeded entries are never evicted. Replaces previously seeded positions;
+   * pass nullptr to clear them. Ignored if the mask dimensions do not match.
+   */
+  void setCalibratedDeadPixels( const DeadPixelMask *mask );
+
+  /*!
+   * Extract a width*height host-endian frame from the little-endian padded
+   * transfer body `data`. Pixels reading 0 / 0xFFFF are replaced with a 3x3
+   * gaussian over their valid neighbours (0 if none is valid).
+   * The geometry is a template parameter so each camera model gets its own
+   * copy loop with constant bounds; it must match the one passed to reset().
+   * @param learn If false the frame is inpainted but does not update the
+   *        learned positions (e.g. for boot transfers with atypical content).
+   * @param column_offset Optional per-column offset subtracted from every
+   *        pixel (inpainted ones included) in the same copy, clamped to
+   *        [0, 0xFFFF]. Sentinels are detected on the uncorrected values.
+   * @return The number of pixels that read as sentinels.
+   */
+  template<int Width, int Height, int RowStep>
+  size_t extract( const uint16_t *__restrict__ data, uint16_t *__restrict__ frame,
+                bool learn = true, const int32_t *column_offset = nullptr )
+  {
+    assert( width_ == Width && height_ == Height && row_step_ == RowStep );
+    const size_t sentinels =
+        column_offset == nullptr
+            ? blindCopy<Width, Height, RowStep, false>( data, frame, column_offset )
+            : blindCopy<Width, Height, RowStep, true>( data, frame, column_offset );
+    fixKnown( data, frame, sentinels, learn, column_offset );
+    return sentinels;
+  }
+
+  /*!
+   * Like extract() for the `region_width` x `region_height` region at
+   * (`region_x`, `region_y`) only, into a region-sized `frame`. Sentinels are
+   * inpainted from the transfer, so pixels on the region border see their
+   * neighbours outside it. A region shows too little of the frame to learn
+   * from; the learned positions are used but not updated, and sentinels at
+   * other positions are found by a scan of the region.
+   * @param column_offset Optional per-column offset of the full frame.
+   * @return The number of pixels of the region that read as sentinels.
+   */
+  size_t extractRegion( const uint16_t *data, uint16_t *frame, int region_x, int region_y,
+                        int region_width, int region_height,
+                        const int32_t *column_offset = nullptr );
+
+  //! Number of positions in the known list (learned + calibrated).
+  size_t knownCount() const noexcept { return index_.size(); }
+
+  //! Number of frames that needed the full fallback scan since reset().
+  size_t fallbackScanCount() const noexcept { return fallback_scans_; }
+
+private:
+  //! Convert-and-store copy of the visible image. The sentinel count is
+  //! branch-free so the loop stays straight; it is the per-frame check that
+  //! the known list suffices.
+  template<int Width, int Height, int RowStep, bool ColumnOffset>
+  static size_t blindCopy( const uint16_t *__restrict__ data, uint16_t *__restrict__ frame,
+                           const int32_t *__restrict__ column_offset )
+  {
+    size_t sentinels = 0;
+    for ( int y = 0; y < Height; ++y ) {
+      const uint16_t *row_in = data + static_cast<size_t>( y ) * RowStep;
+      uint16_t *row_out = frame + static_cast<size_t>( y ) * Width;
+      for ( int x = 0; x < Width; ++x ) {
+        const uint16_t v = le16toh( row_in[x] );
+        if constexpr ( ColumnOffset ) {
+          const int32_t corrected = static_cast<int32_t>( v ) - column_offset[x];
+          row_out[x] = static_cast<uint16_t>( std::clamp( corrected, 0, 0xFFFF ) );
+        } else {
+          row_out[x] = v;
+        }
+        sentinels += static_cast<size_t>( ( v == 0 ) | ( v == 0xFFFF ) );
+      }
+    }
+    return sentinels;
+  }
+
+  //! Inpaint the known positions, then fall back to a full scan if the blind
+  //! copy counted more sentinels than were found there.
+  void fixKnown( const uint16_t *data, uint16_t *frame, size_t sentinels, bool learn,
+                 const int32_t *column_offset );
+
+  //! Gaussian over the valid 3x3 neighbours of raw position `raw_index`,
+  //! restricted to the in-bounds neighbours flagged in `neighbor_mask`.
+  uint16_t inpaint( const uint16_t *data, uint32_t raw_index, uint8_t neighbor_mask ) const;
+
+  uint8_t neighborMask( int x, int y ) const;
+
+  void scanAndLearn( const uint16_t *data, uint16_t *frame, bool learn,
+                     const int32_t *column_offset );
+
+  void decayCandidates();
+
+  void rebuild();
+
+  int width_ = 0;
+  int height_ = 0;
+  int row_step_ = 0;
+  //! Raw offsets of the eight 3x3 neighbours, row-major, centre skipped.
+  int neighbor_offsets_[8] = { 0 };
+
+  //! Dense per-pixel state: hysteresis score and membership flags.
+  std::vector<uint8_t> score_;
+  std::vector<uint8_t> flags_;
+
+  //! Known list (structure-of-arrays).
+  std::vector<uint32_t> index_;        //!< y * width + x
+  std::vector<uint32_t> raw_index_;    //!< y * row_step + x
+  std::vector<uint8_t> neighbor_mask_; //!< bit k set = neighbour k is in bounds
+
+  uint32_t frames_since_decay_ = 0;
+  size_t fallback_scans_ = 0;
+  bool dirty_ = false;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_SENTINEL_MAP_HPP
@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_DEVICE_TRAITS_HPP
+#define OPENSEEKTHERMAL_DEVICE_TRAITS_HPP
+
+#include "../exceptions.hpp"
+#include "./seek_device.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace openseekthermal
+{
+
+/*!
+ * Compile-time geometry and transfer layout of a camera model.
+ *
+ * Only specialized for the supported models. The per-frame kernels are
+ * instantiated per model from these constants so the loop bounds and strides
+ * are known to the compiler; the runtime accessors on SeekDevice and
+ * FrameHeader are derived from the same values via visitDeviceTraits().
+ *
+ * A transfer is `kTransferRows` rows of `kRowStride` little-endian uint16,
+ * the first `kFrameHeaderSize` bytes of which are the frame header. The
+ * visible image is the first `kWidth` pixels of `kHeight` rows following
+ * the header; column `kWidth` is the pad column used for drift compensation.
+ */
+template<SeekDevice::Type DeviceType>
+struct DeviceTraits;
+
+template<>
+struct DeviceTraits<SeekDevice::Type::SeekThermalCompact> {
+  static constexpr SeekDevice::Type kType = SeekDevice::Type::SeekThermalCompact;
+  static constexpr uint16_t kProductID = 0x0010;
+  static constexpr int kMaxFramerate = 8;
+
+  static constexpr int kWidth = 206;
+  static constexpr int kHeight = 156;
+  static constexpr int kRowStride = 208; //!< Padded row length in pixels.
+  static constexpr int kTransferRows = 156;
+  static constexpr int kFrameHeaderSize = 0;
+  static constexpr int kTransferRequestSize = 16224;
+
+  //! Header bytes retained in FrameHeader. The Compact interleaves its header
+  //! with the first image row.
+  static constexpr size_t kMinHeaderSize = 82;
+  static constexpr int kFrameNumberOffset = 80;
+  static constexpr int kFrameTypeOffset = 20;
+  //! No per-column dark-reference row.
+  static constexpr int kColumnReferenceRow = -1;
+
+  static constexpr int kRowStep = kRowStride * 2;
+  static constexpr int kTransferTotalSize = kRowStep * kTransferRows;
+  static constexpr uint32_t kTransferDeviceRequestSize = kRowStride * kTransferRows;
+};
+
+//! Shared layout of the 320x240 cores (Compact Pro and Nano 300).
+struct DeviceTraits320x240 {
+  static constexpr uint16_t kProductID = 0x0011;
+
+  static constexpr int kWidth = 320;
+  static constexpr int kHeight = 240;
+  static constexpr int kRowStride = 342; //!< Padded row length in pixels.
+  static constexpr int kTransferRows = 260;
+  static constexpr int kFrameHeaderSize = 2736; //!< 4 header rows.
+  static constexpr int kTransferRequestSize = 13680;
+
+  //! Header rows 0-2 (row 2 = per-column dark reference, useful for drift
+  //! analysis). Row 3 is all zeros on thermal frames, excluded.
+  static constexpr size_t kMinHeaderSize = 2052;
+  static constexpr int kFrameNumberOffset = 2;
+  static constexpr int kFrameTypeOffset = 4;
+  //! Transfer row holding the per-column dark reference (first kWidth pixels).
+  static constexpr int kColumnReferenceRow = 2;
+
+  static constexpr int kRowStep = kRowStride * 2;
+  static constexpr int kTransferTotalSize = kRowStep * kTransferRows;
+  static constexpr uint32_t kTransferDeviceRequestSize = kRowStride * kTransferRows;
+};
+
+template<>
+struct DeviceTraits<SeekDevice::Type::SeekThermalCompactPro> : DeviceTraits320x240 {
+  static constexpr SeekDevice::Type kType = SeekDevice::Type::SeekThermalCompactPro;
+  static constexpr int kMaxFramerate = 15;
+};
+
+template<>
+struct DeviceTraits<SeekDevice::Type::SeekThermalNano300> : DeviceTraits320x240 {
+  static constexpr SeekDevice::Type kType = SeekDevice::Type::SeekThermalNano300;
+  static constexpr int kMaxFramerate = 25;
+};
+
+static_assert( DeviceTraits<SeekDevice::Type::SeekThermalCompact>::kTransferTotalSize == 64896 );
+static_assert( DeviceTraits320x240::kTransferTotalSize == 177840 );
+static_assert( DeviceTraits320x240::kFrameHeaderSize == 4 * DeviceTraits320x240::kRowStep );
+
+/*!
+ * Invoke `fn` with a default-constructed `DeviceTraits<type>` for the runtime
+ * device type. This is the single switch that maps a runtime type onto the
+ * compile-time traits; call it once and keep the result (or a kernel
+ * instantiated from it) rather than on every frame.
+ * @param what Name used in the error message for unsupported types.
+ * @throws InvalidDeviceError if `type` is not a supported model.
+ */
+template<typename Fn>
+auto visitDeviceTraits( SeekDevice::Type type, const char *what, Fn &&fn )
+{
+  switch ( type ) {
+  case SeekDevice::Type::SeekThermalCompact:
+    return fn( DeviceTraits<SeekDevice::Type::SeekThermalCompact>{} );
+  case SeekDevice::Type::SeekThermalCompactPro:
+    return fn( DeviceTraits<SeekDevice::Type::SeekThermalCompactPro>{} );
+  case SeekDevice::Type::SeekThermalNano300:
+    return fn( DeviceTraits<SeekDevice::Type::SeekThermalNano300>{} );
+  default:
+    break;
+  }
+  throw InvalidDeviceError( std::string( what ) + " not implemented for " + to_string( type ) );
+}
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_DEVICE_TRAITS_HPP
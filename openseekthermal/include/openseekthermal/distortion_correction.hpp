@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_DISTORTION_CORRECTION_HPP
+#define OPENSEEKTHERMAL_DISTORTION_CORRECTION_HPP
+
+namespace openseekthermal
+{
+
+/*!
+ * Lens distortion model (Brown-Conrady, as used by OpenCV) in pixel units.
+ * For normalized coordinates xn = (x - cx) / fx, yn = (y - cy) / fy of an
+ * ideal pinhole image and r² = xn² + yn², the lens maps them to
+ *     xd = xn * (1 + k1 r² + k2 r⁴ + k3 r⁶) + 2 p1 xn yn + p2 (r² + 2 xn²)
+ *     yd = yn * (1 + k1 r² + k2 r⁴ + k3 r⁶) + p1 (r² + 2 yn²) + 2 p2 xn yn
+ * Barrel distortion has k1 < 0. The corrected frame keeps the size and the
+ * intrinsics of the sensor image; corrected pixels that map outside the
+ * sensor repeat its edge.
+ *
+ * Loaded as part of a CameraCalibration; see camera_calibration.hpp.
+ */
+class DistortionCorrection
+{
+public:
+  DistortionCorrection() = default;
+
+  int width = 0;
+  int height = 0;
+  double fx = 0.0;
+  double fy = 0.0;
+  double cx = 0.0;
+  double cy = 0.0;
+  double k1 = 0.0;
+  double k2 = 0.0;
+  double k3 = 0.0;
+  double p1 = 0.0;
+  double p2 = 0.0;
+
+  //! Whether the model is usable: positive size and focal lengths.
+  bool valid() const noexcept { return width > 0 && height > 0 && fx > 0.0 && fy > 0.0; }
+
+  /*!
+   * Position (`sx`, `sy`) in the sensor image that the corrected pixel
+   * (`x`, `y`) is sampled from.
+   */
+  void distort( double x, double y, double &sx, double &sy ) const;
+
+  /*!
+   * Inverse of distort(): the corrected position of the sensor pixel
+   * (`sx`, `sy`), e.g. to map detections in uncorrected frames. Solved by
+   * fixed-point iteration, which converges for the moderate distortion of
+   * real lenses.
+   */
+  void undistort( double sx, double sy, double &x, double &y ) const;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_DISTORTION_CORRECTION_HPP
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_FRAME_SCALER_HPP
+#define OPENSEEKTHERMAL_FRAME_SCALER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openseekthermal
+{
+
+enum class ScalingFilter {
+  Bilinear, //!< 2x2 taps; smooth, never overshoots.
+  Bicubic   //!< 4x4 Catmull-Rom taps; sharper edges with slight overshoot.
+};
+
+/*!
+ * Resamples 16-bit frames, e.g. sensor-resolution centi-Kelvin frames to
+ * display resolution before they are colorized. Scaling the single 16-bit
+ * channel and applying a colormap at the output resolution is several times
+ * cheaper than scaling the colorized RGBA frame.
+ *
+ * Pixel centres are aligned and the edge pixels are repeated. The filter is
+ * separable: each source row is filtered horizontally once into a small ring
+ * of rows, and every output row is a weighted sum of two or four of those
+ * rows, with the same weights along the row, so it vectorizes. Weights are in
+ * fixed point; flat regions are reproduced exactly.
+ *
+ * Intended for enlarging; reducing by more than a factor of two skips source
+ * pixels, use binning instead (see SeekThermalCamera::setOutputBinning()).
+ */
+class FrameScaler
+{
+public:
+  FrameScaler() = default;
+
+  /*!
+   * Scale source_width x source_height frames to width x height.
+   * @throws std::invalid_argument if a size is not positive.
+   */
+  FrameScaler( int source_width, int source_height, int width, int height,
+               ScalingFilter filter = ScalingFilter::Bilinear );
+
+  int sourceWidth() const noexcept { return source_width_; }
+
+  int sourceHeight() const noexcept { return source_height_; }
+
+  int width() const noexcept { return width_; }
+
+  int height() const noexcept { return height_; }
+
+  ScalingFilter filter() const noexcept { return filter_; }
+
+  /*!
+   * Scale `source`, whose rows are `source_stride` pixels apart, into
+   * `output`, whose rows are `output_stride` pixels apart. Bicubic results are
+   * clamped to the 16-bit range.
+   */
+  void scale( const uint16_t *source, size_t source_stride, uint16_t *output,
+              size_t output_stride );
+
+private:
+  //! Source indices and Q12 weights of the taps of each output position.
+  struct Taps {
+    std::vector<int> index;
+    std::vector<int32_t> weight;
+  };
+
+  static Taps computeTaps( int source_size, int size, int taps, ScalingFilter filter );
+
+  //! Horizontally filter source row `y` into the ring slot of that row.
+  void filterRow( const uint16_t *row, int y );
+
+  int source_width_ = 0;
+  int source_height_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  ScalingFilter filter_ = ScalingFilter::Bilinear;
+  int taps_ = 2;
+  Taps columns_;
+  Taps rows_;
+  //! Horizontally filtered source rows in Q2, `taps_` slots of `width_`, and
+  //! the source row held by each slot (-1: none).
+  std::vector<int32_t> ring_;
+  std::vector<int> ring_row_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_FRAME_SCALER_HPP
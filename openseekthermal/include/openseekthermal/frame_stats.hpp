@@ -0,0 +1,47 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_FRAME_STATS_HPP
+#define OPENSEEKTHERMAL_FRAME_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace openseekthermal
+{
+
+/*!
+ * Statistics of a grabbed 16-bit frame, computed by the driver while the
+ * frame is still in cache from the final processing pass, so consumers
+ * never have to rescan the pixels. They describe the frame the processing
+ * finishes in: centi-Kelvin if requested and a temperature mapping is
+ * installed, otherwise the corrected counts. For non-thermal frames they
+ * describe the extracted raw counts.
+ */
+struct FrameStats {
+  //! Histogram bins of kHistogramBinWidth values each, covering [0, 0xFFFF].
+  static constexpr int kHistogramBins = 256;
+  static constexpr int kHistogramBinWidth = 65536 / kHistogramBins;
+
+  size_t pixel_count = 0;
+  uint16_t min = 0;
+  uint16_t max = 0;
+  double mean = 0.0;
+  //! Pixels of the transfer that read as dead-pixel sentinels (0 / 0xFFFF)
+  //! and were inpainted.
+  size_t sentinel_count = 0;
+  //! Pixel count per bin; the bin of value v is v / kHistogramBinWidth.
+  std::array<uint32_t, kHistogramBins> histogram{};
+
+  /*!
+   * Value below which `fraction` (in [0, 1]) of the pixels lie, interpolated
+   * linearly within the histogram bin and limited to [min, max].
+   * Returns 0 for an empty frame.
+   */
+  double percentile( double fraction ) const noexcept;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_FRAME_STATS_HPP
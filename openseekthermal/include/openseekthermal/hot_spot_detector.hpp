@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_HOT_SPOT_DETECTOR_HPP
+#define OPENSEEKTHERMAL_HOT_SPOT_DETECTOR_HPP
+
+#include "./processing_stage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace openseekthermal
+{
+
+/*!
+ * Settings of a HotSpotDetector. `threshold` is in the units of the analyzed
+ * frame, i.e. centi-Kelvin after the "temperature" stage: 100 * °C + 27315.
+ */
+struct HotSpotSettings {
+  uint16_t threshold = 0xFFFF; //!< Pixels at or above it are hot.
+  size_t min_area = 1;         //!< Smaller regions are not reported, in pixels.
+  bool eight_connected = true; //!< Whether diagonal neighbours are connected.
+};
+
+//! A connected region of hot pixels.
+struct HotSpot {
+  int x_min = 0; //!< Bounding box, inclusive.
+  int y_min = 0;
+  int x_max = 0;
+  int y_max = 0;
+  double centroid_x = 0.0;
+  double centroid_y = 0.0;
+  int peak_x = 0; //!< Hottest pixel; the first in row-major order on ties.
+  int peak_y = 0;
+  uint16_t peak = 0;
+  size_t area = 0; //!< In pixels.
+  double mean = 0.0;
+};
+
+/*!
+ * Finds the connected regions of a frame at or above a threshold in a single
+ * pass over the rows.
+ *
+ * Each row is reduced to runs of hot pixels, skipping cold stretches 16
+ * pixels at a time. Runs overlapping a run of the row above are merged with
+ * union-find, and the per-run sums are folded into one HotSpot per region at
+ * the end of the frame. Work and memory scale with the number of runs rather
+ * than pixels, so a frame with few hot regions costs little more than one
+ * read of it.
+ */
+class HotSpotDetector
+{
+public:
+  explicit HotSpotDetector( const HotSpotSettings &settings = {} ) : settings_( settings ) { }
+
+  //! Takes effect with the next frame.
+  void setSettings( const HotSpotSettings &settings ) { settings_ = settings; }
+
+  const HotSpotSettings &settings() const noexcept { return settings_; }
+
+  //! Coordinates of pixel (0, 0) of the analyzed frames, added to those of
+  //! the hot spots. Takes effect with the next frame.
+  void setOrigin( int x, int y ) noexcept
+  {
+    origin_x_ = x;
+    origin_y_ = y;
+  }
+
+  //! Analyze the width*height frame `frame`. Equivalent to addRows() over all rows.
+  void detect( const uint16_t *frame, int width, int height );
+
+  /*!
+   * Add rows [row_begin, row_end) of the width*height frame `frame`. Rows must
+   * be added in order, starting at 0; adding row 0 starts a new frame. The
+   * hot spots are available once the last row was added.
+   */
+  void addRows( const uint16_t *frame, int width, int height, int row_begin, int row_end );
+
+  //! Whether a complete frame was analyzed.
+  bool valid() const noexcept { return complete_; }
+
+  //! Hot spots of the last complete frame, ordered by their first pixel in
+  //! row-major order.
+  const std::vector<HotSpot> &hotSpots() const noexcept { return hot_spots_; }
+
+private:
+  struct Run {
+    int y;
+    int x_begin;
+    int x_end; //!< One past the last pixel.
+    int peak_x;
+    uint16_t peak;
+    uint64_t sum;
+  };
+
+  void addRow( const uint16_t *row, int y );
+
+  void finishFrame();
+
+  uint32_t findRoot( uint32_t run ) noexcept;
+
+  HotSpotSettings settings_;
+  HotSpotSettings frame_settings_; //!< Settings of the frame in progress.
+  int origin_x_ = 0;
+  int origin_y_ = 0;
+  int frame_origin_x_ = 0; //!< Origin of the frame in progress.
+  int frame_origin_y_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  int rows_ = 0; //!< Rows of the current frame added so far.
+  bool complete_ = false;
+  //! Runs of the current frame in row-major order, and the index range of the
+  //! previous row's runs.
+  std::vector<Run> runs_;
+  size_t previous_row_begin_ = 0;
+  size_t previous_row_end_ = 0;
+  //! Union-find forest over runs_; a root is the first run of its region.
+  std::vector<uint32_t> parent_;
+  std::vector<uint32_t> region_of_root_;
+  std::vector<HotSpot> hot_spots_;
+};
+
+/*!
+ * Analysis stage (see ProcessingStage) that feeds the frame at its position
+ * in the chain into a HotSpotDetector, band by band:
+ *
+ *     HotSpotSettings settings;
+ *     settings.threshold = 100 * 60 + 27315; // 60 °C
+ *     auto hot_spots = std::make_shared<HotSpotStage>( settings );
+ *     camera->addProcessingStage( hot_spots, "" );
+ *     camera->grabFrame( ... );
+ *     for ( const HotSpot &spot : *hot_spots->hotSpots() ) { ... }
+ *
+ * Coordinates are the sensor's, also with a processing window.
+ *
+ * The detector runs in the grabbing thread and publishes the hot spots of
+ * each frame once it is complete. All methods are thread-safe.
+ */
+class HotSpotStage : public ProcessingStage
+{
+public:
+  explicit HotSpotStage( const HotSpotSettings &settings = {} ) : settings_( settings ) { }
+
+  const char *name() const noexcept override { return "hot_spots"; }
+
+  void process( const StageRows &rows ) override;
+
+  //! Takes effect with the next frame.
+  void setSettings( const HotSpotSettings &settings );
+
+  HotSpotSettings settings() const;
+
+  //! Hot spots of the last complete frame, empty before the first. A new
+  //! list is published per frame, so a returned list never changes.
+  std::shared_ptr<const std::vector<HotSpot>> hotSpots() const;
+
+private:
+  mutable std::mutex mutex_;
+  HotSpotSettings settings_;
+  std::shared_ptr<const std::vector<HotSpot>> hot_spots_ =
+      std::make_shared<const std::vector<HotSpot>>();
+  //! Used by the grabbing thread only.
+  HotSpotDetector detector_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_HOT_SPOT_DETECTOR_HPP
@@ -0,0 +1,173 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_METRICS_HPP
+#define OPENSEEKTHERMAL_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace openseekthermal
+{
+
+//! Summary of a LatencyHistogram. Quantiles are accurate to about 6 %.
+struct LatencySnapshot {
+  std::string name;
+  uint64_t count = 0;
+  double sum_ms = 0.0;
+  double p50_ms = 0.0;
+  double p90_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+/*!
+ * Lock-free latency histogram with log-linear buckets: eight per power of
+ * two of nanoseconds, i.e. a bucket width of at most 12.5 %. Recording is
+ * a few relaxed atomic increments, cheap enough to leave on in production;
+ * snapshots may be taken concurrently from any thread.
+ */
+class LatencyHistogram
+{
+public:
+  explicit LatencyHistogram( std::string name ) : name_( std::move( name ) ) { }
+
+  const std::string &name() const noexcept { return name_; }
+
+  void record( std::chrono::nanoseconds duration ) noexcept;
+
+  LatencySnapshot snapshot() const;
+
+  void reset() noexcept;
+
+private:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr int kMaxExponent = 40; //!< Longer durations (> 18 min) are clamped.
+  static constexpr size_t kBucketCount = ( kMaxExponent - kSubBucketBits + 2 )
+                                         << kSubBucketBits;
+
+  static size_t bucketIndex( uint64_t ns ) noexcept;
+  //! Midpoint of bucket `index` in nanoseconds.
+  static double bucketValue( size_t index ) noexcept;
+
+  std::string name_;
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> sum_ns_{ 0 };
+  std::atomic<uint64_t> max_ns_{ 0 };
+};
+
+//! Records the lifetime of the scope into a LatencyHistogram.
+class ScopedLatency
+{
+public:
+  explicit ScopedLatency( LatencyHistogram &histogram )
+      : histogram_( histogram ), start_( std::chrono::steady_clock::now() )
+  {
+  }
+
+  ~ScopedLatency() { histogram_.record( std::chrono::steady_clock::now() - start_ ); }
+
+  ScopedLatency( const ScopedLatency & ) = delete;
+  ScopedLatency &operator=( const ScopedLatency & ) = delete;
+
+private:
+  LatencyHistogram &histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+//! Point-in-time copy of a MetricsRegistry.
+struct MetricsSnapshot {
+  uint64_t frames = 0;          //!< Transfers received.
+  uint64_t thermal_frames = 0;  //!< Transfers that were thermal frames.
+  uint64_t dropped_frames = 0;  //!< Gaps in the camera's frame counter.
+  uint64_t transfer_errors = 0; //!< Failed or incomplete USB transfers.
+  double frame_rate = 0.0;      //!< Smoothed transfer rate in Hz.
+  LatencySnapshot transfer;     //!< Time to receive one transfer over USB.
+  LatencySnapshot processing;   //!< Host processing time of one grab.
+  //! Per ProcessingStage, see ProcessingStage::name(). Fused built-in stages
+  //! share one entry named e.g. "vignette+temperature".
+  std::vector<LatencySnapshot> stages;
+};
+
+/*!
+ * Per-camera metrics: frame, drop and error counters, the frame rate and
+ * latency histograms of the USB transfer, the processing of a grab and each
+ * processing stage. Updated by the grabbing thread; snapshot() may be called
+ * from any thread.
+ */
+class MetricsRegistry
+{
+public:
+  MetricsRegistry();
+
+  LatencyHistogram &transferLatency() noexcept { return transfer_; }
+
+  LatencyHistogram &processingLatency() noexcept { return processing_; }
+
+  /*!
+   * Histogram of the stage `name`, created on first use. The reference stays
+   * valid for the lifetime of the registry; look it up once, not per frame.
+   */
+  LatencyHistogram &stageLatency( const std::string &name );
+
+  //! Count a received transfer with the camera frame counter `frame_number`
+  //! (-1 if unknown) at time `now`. Counter gaps are counted as drops.
+  void recordFrame( int frame_number, bool thermal,
+                    std::chrono::steady_clock::time_point now ) noexcept;
+
+  void recordTransferError() noexcept
+  {
+    transfer_errors_.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  MetricsSnapshot snapshot() const;
+
+  //! Zero all counters and histograms and restart the frame rate and drop
+  //! tracking from the next frame. Stage histograms stay registered.
+  void reset();
+
+private:
+  LatencyHistogram transfer_{ "transfer" };
+  LatencyHistogram processing_{ "processing" };
+  mutable std::mutex stages_mutex_;
+  std::vector<std::unique_ptr<LatencyHistogram>> stages_;
+  std::atomic<uint64_t> frames_{ 0 };
+  std::atomic<uint64_t> thermal_frames_{ 0 };
+  std::atomic<uint64_t> dropped_frames_{ 0 };
+  std::atomic<uint64_t> transfer_errors_{ 0 };
+  //! Exponentially smoothed interval between transfers.
+  std::atomic<uint64_t> frame_interval_ns_{ 0 };
+  //! Set by reset(); the grabbing thread then restarts the tracking below.
+  std::atomic<bool> restart_frame_tracking_{ false };
+  //! Written by the grabbing thread only.
+  int last_frame_number_ = -1;
+  std::chrono::steady_clock::time_point last_frame_time_{};
+};
+
+/*!
+ * Write `snapshot` in the Prometheus text exposition format (version 0.0.4).
+ * The latencies are exported as summaries in seconds with the quantiles 0.5,
+ * 0.9 and 0.99 plus a `_max` gauge. Every series carries `camera="<camera>"`.
+ */
+void writePrometheusText( std::ostream &out, const MetricsSnapshot &snapshot,
+                          const std::string &camera );
+
+/*!
+ * Write writePrometheusText() output to `path` for a file-based scraper
+ * (e.g. the node_exporter textfile collector). The file is written next to
+ * `path` and renamed over it, so readers never see a partial file.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void writePrometheusFile( const std::string &path, const MetricsSnapshot &snapshot,
+                          const std::string &camera );
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_METRICS_HPP
@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_NON_UNIFORMITY_CORRECTION_HPP
+#define OPENSEEKTHERMAL_NON_UNIFORMITY_CORRECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace openseekthermal
+{
+
+/*!
+ * Per-pixel two-point non-uniformity correction (NUC):
+ *     corrected = gain[i] * counts + offset[i]
+ * applied to the flat-field and vignette corrected counts. The shutter
+ * flat-field removes the pixel offsets at the shutter temperature; the gains
+ * remove the responsivity differences that otherwise show up as fixed
+ * pattern noise in scenes far from it. Fit by the calibration tool from two
+ * uniform scenes at different temperatures.
+ *
+ * Gains and offsets are stored as Q12 fixed point, gains within [0, 4) and
+ * offsets within ±131072 counts, so the correction is an integer
+ * multiply-add that cannot overflow.
+ *
+ * Loaded as part of a CameraCalibration; see camera_calibration.hpp.
+ */
+class NonUniformityCorrection
+{
+public:
+  static constexpr int kFractionBits = 12;
+  static constexpr int32_t kMaxGain = 4 << kFractionBits;      //!< Exclusive.
+  static constexpr int32_t kMaxOffset = 131072 << kFractionBits; //!< Inclusive, both signs.
+
+  NonUniformityCorrection() = default;
+
+  /*!
+   * Build from width*height gains and offsets in counts, rounded to Q12 and
+   * clamped to the supported range.
+   * @throws std::invalid_argument if a table does not have width*height entries.
+   */
+  NonUniformityCorrection( int width, int height, const std::vector<double> &gain,
+                           const std::vector<double> &offset );
+
+  /*!
+   * Use width*height precomputed Q12 tables without copying them, e.g. from a
+   * memory-mapped binary calibration file. The values must be in range.
+   */
+  NonUniformityCorrection( int width, int height, std::shared_ptr<const int32_t> gain,
+                           std::shared_ptr<const int32_t> offset );
+
+  int width() const noexcept { return width_; }
+
+  int height() const noexcept { return height_; }
+
+  //! Q12 gain table, width*height; null for a default-constructed object.
+  const int32_t *gainTable() const noexcept { return gain_.get(); }
+
+  //! Q12 offset table in counts, width*height.
+  const int32_t *offsetTable() const noexcept { return offset_.get(); }
+
+  double gain( size_t index ) const { return gain_.get()[index] / double( 1 << kFractionBits ); }
+
+  double offset( size_t index ) const
+  {
+    return offset_.get()[index] / double( 1 << kFractionBits );
+  }
+
+  /*!
+   * Apply the correction in-place to a width*height host-endian uint16
+   * frame buffer. Output is clamped to [0, 0xFFFF].
+   */
+  void apply( uint16_t *frame ) const;
+
+private:
+  int width_ = 0;
+  int height_ = 0;
+  //! Immutable, so copies share the tables.
+  std::shared_ptr<const int32_t> gain_;
+  std::shared_ptr<const int32_t> offset_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_NON_UNIFORMITY_CORRECTION_HPP
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_PROCESSING_STAGE_HPP
+#define OPENSEEKTHERMAL_PROCESSING_STAGE_HPP
+
+#include "./detail/frame.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace openseekthermal
+{
+
+//! The rows a ProcessingStage produces in one ProcessingStage::process() call.
+struct StageRows {
+  const uint16_t *input = nullptr; //!< Row 0 of the stage's width*height input frame.
+  uint16_t *output = nullptr;      //!< Row 0 of the output frame. May equal `input`.
+  int width = 0;
+  int height = 0;
+  int row_begin = 0; //!< First row to produce.
+  int row_end = 0;   //!< One past the last row to produce.
+  //! Sensor coordinates of row 0, column 0: the origin of the processed
+  //! region while SeekThermalCamera::setProcessingWindow() is set, else 0.
+  int origin_x = 0;
+  int origin_y = 0;
+};
+
+/*!
+ * A step of the thermal-frame processing chain of a SeekThermalCamera, see
+ * SeekThermalCamera::addProcessingStage(). Frames are host-endian uint16:
+ * corrected counts in front of the built-in "temperature" stage, its main
+ * output (centi-Kelvin, or counts without a temperature mapping) after it.
+ *
+ * The chain runs in row bands: process() is called several times per frame,
+ * each time for the next rows, interleaved with the other stages so a band is
+ * still in cache when the next stage reads it. Within a call, the input rows
+ * up to halo() rows around [row_begin, row_end) are complete; rows further
+ * away must not be read. Stages whose halo is 0 or that are in place get
+ * `output == input` except when reading the extracted frame or writing the
+ * final output, so every stage has to handle both.
+ *
+ * Analysis stages such as RoiStatisticsStage, HotSpotStage and AlarmStage
+ * only read the frame and forward it with passThroughRows(). Appended after
+ * the built-in "temperature" stage, they see centi-Kelvin.
+ */
+class ProcessingStage
+{
+public:
+  using SharedPtr = std::shared_ptr<ProcessingStage>;
+
+  virtual ~ProcessingStage() = default;
+
+  //! Name used for lookup and in the stage latency metrics.
+  virtual const char *name() const noexcept = 0;
+
+  //! Input rows read above and below each produced row.
+  virtual int halo() const noexcept { return 0; }
+
+  //! Whether the stage can write over its input. Defaults to true for
+  //! point-wise (halo 0) stages; others get a separate output frame.
+  virtual bool inPlace() const noexcept { return halo() == 0; }
+
+  //! Disabled stages are skipped; checked once per frame.
+  virtual bool enabled() const noexcept { return true; }
+
+  //! Called once per thermal frame before the first process() call.
+  virtual void beginFrame( const FrameHeader & /*header*/, int /*width*/, int /*height*/ ) { }
+
+  virtual void process( const StageRows &rows ) = 0;
+};
+
+//! Copy the rows to produce from `rows.input` to `rows.output`, unless the
+//! stage runs in place. For stages that do not modify the frame.
+inline void passThroughRows( const StageRows &rows ) noexcept
+{
+  if ( rows.output == rows.input )
+    return;
+  const size_t offset = static_cast<size_t>( rows.row_begin ) * rows.width;
+  const size_t count = static_cast<size_t>( rows.row_end - rows.row_begin ) * rows.width;
+  std::memcpy( rows.output + offset, rows.input + offset, count * sizeof( uint16_t ) );
+}
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_PROCESSING_STAGE_HPP
@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_ROI_STATISTICS_HPP
+#define OPENSEEKTHERMAL_ROI_STATISTICS_HPP
+
+#include "./processing_stage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openseekthermal
+{
+
+//! Axis-aligned rectangle of a frame in pixels.
+struct RegionOfInterest {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+//! Statistics of the pixels of a RegionOfInterest, in the units of the frame.
+struct RoiStatistics {
+  size_t pixel_count = 0; //!< 0 if the region lies outside the frame.
+  double mean = 0.0;
+  double stddev = 0.0;
+  uint16_t min = 0;
+  uint16_t max = 0;
+};
+
+/*!
+ * Constant-time statistics of arbitrary rectangles of a frame, for tracking
+ * many ROIs at the cost of about one.
+ *
+ * Per frame, one pass builds the integral images (summed-area tables) of the
+ * pixels and their squares, which give the sum and thus mean and standard
+ * deviation of any rectangle from four lookups each. Min and max come from a
+ * sparse pyramid whose level k holds the extrema of the 2^k x 2^k block at
+ * every position; a rectangle is covered by overlapping blocks of the largest
+ * level that fits, e.g. 4 blocks for a square. The levels are built with
+ * vectorized row-wise min/max passes over the previous level.
+ */
+class RoiAnalyzer
+{
+public:
+  //! Deepest pyramid level; blocks of at most 2^kMaxPyramidLevels pixels.
+  static constexpr int kMaxPyramidLevels = 6;
+
+  /*!
+   * @param pyramid_levels Levels above the frame itself, clamped to
+   *        [0, kMaxPyramidLevels]. Each costs a frame-sized min and max
+   *        buffer and a pass per frame; ROIs wider and taller than
+   *        2^pyramid_levels need more block lookups.
+   */
+  explicit RoiAnalyzer( int pyramid_levels = 4 );
+
+  //! Analyze the width*height frame `frame`. Equivalent to addRows() over all rows.
+  void update( const uint16_t *frame, int width, int height );
+
+  /*!
+   * Add rows [row_begin, row_end) of the width*height frame `frame`. Rows must
+   * be added in order, starting at 0; adding row 0 starts a new frame. The
+   * results are available once the last row was added.
+   */
+  void addRows( const uint16_t *frame, int width, int height, int row_begin, int row_end );
+
+  /*!
+   * Coordinates of pixel (0, 0) of the analyzed frames, e.g. the origin of a
+   * cut-out of the sensor frame. query() takes ROIs in these coordinates.
+   * Takes effect with the next frame.
+   */
+  void setOrigin( int x, int y ) noexcept
+  {
+    origin_x_ = x;
+    origin_y_ = y;
+  }
+
+  //! Whether a complete frame was analyzed.
+  bool valid() const noexcept { return complete_; }
+
+  int width() const noexcept { return width_; }
+
+  int height() const noexcept { return height_; }
+
+  //! Statistics of `roi`, relative to the origin (see setOrigin()), clipped to the frame.
+  RoiStatistics query( const RegionOfInterest &roi ) const noexcept;
+
+  //! Statistics of the whole frame.
+  RoiStatistics frameStatistics() const noexcept;
+
+private:
+  void buildPyramid();
+
+  size_t integralIndex( int x, int y ) const noexcept
+  {
+    return static_cast<size_t>( y ) * ( width_ + 1 ) + x;
+  }
+
+  int pyramid_levels_;
+  int origin_x_ = 0;
+  int origin_y_ = 0;
+  //! Origin of the frame in progress or the last complete one.
+  int frame_origin_x_ = 0;
+  int frame_origin_y_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  int rows_ = 0; //!< Rows of the current frame added so far.
+  bool complete_ = false;
+  //! (width + 1) x (height + 1) with a zero first row and column.
+  std::vector<uint64_t> sum_;
+  std::vector<uint64_t> sum_squares_;
+  //! Level k at (x, y): extremum of [x, x + 2^k) x [y, y + 2^k). Level 0 is a
+  //! copy of the frame.
+  std::vector<std::vector<uint16_t>> min_levels_;
+  std::vector<std::vector<uint16_t>> max_levels_;
+};
+
+/*!
+ * Analysis stage (see ProcessingStage) that feeds the frame at its position
+ * in the chain into a RoiAnalyzer, band by band:
+ *
+ *     auto rois = std::make_shared<RoiStatisticsStage>();
+ *     camera->addProcessingStage( rois, "" );
+ *     camera->grabFrame( ... );
+ *     RoiStatistics bearing = rois->analyzer().query( { 120, 80, 16, 16 } );
+ *
+ * ROIs are in sensor coordinates, also with a processing window.
+ *
+ * The analyzer is updated from the grabbing thread; query it from that
+ * thread, between grabs.
+ */
+class RoiStatisticsStage : public ProcessingStage
+{
+public:
+  explicit RoiStatisticsStage( int pyramid_levels = 4 ) : analyzer_( pyramid_levels ) { }
+
+  const char *name() const noexcept override { return "roi_statistics"; }
+
+  void process( const StageRows &rows ) override;
+
+  const RoiAnalyzer &analyzer() const noexcept { return analyzer_; }
+
+private:
+  RoiAnalyzer analyzer_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_ROI_STATISTICS_HPP
@@ -0,0 +1,29 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_SPATIAL_FILTER_HPP
+#define OPENSEEKTHERMAL_SPATIAL_FILTER_HPP
+
+namespace openseekthermal
+{
+
+/*!
+ * Settings of the edge-preserving (bilateral) spatial filter. Each pixel
+ * becomes the average of its (2*radius+1)² neighbourhood weighted by
+ *     exp(-r² / (2*sigma_spatial²)) * exp(-d² / (2*sigma_range²))
+ * with r the distance to the neighbour and d its count difference to the
+ * centre. Neighbours differing by more than 3*sigma_range get zero weight, so
+ * edges between objects are preserved while flat regions are smoothed.
+ *
+ * `sigma_range` is in drift-compensated raw counts; pick it a few times the
+ * temporal noise so noise is averaged but real contrast is not.
+ */
+struct SpatialFilterSettings {
+  int radius = 1;             //!< 1 (3x3) or 2 (5x5).
+  double sigma_spatial = 1.0; //!< In pixels.
+  double sigma_range = 16.0;  //!< In counts.
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_SPATIAL_FILTER_HPP
@@ -12,6 +12,9 @@
 namespace openseekthermal
 {
 
+//! Unit of float temperature outputs.
+enum class TemperatureUnit { Celsius, Kelvin };
+
 /*!
  * Two-point forward model mapping (shutter-corrected, drift-compensated) raw
  * counts to scene temperature in centi-Kelvin:
@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_TEMPORAL_FILTER_HPP
+#define OPENSEEKTHERMAL_TEMPORAL_FILTER_HPP
+
+namespace openseekthermal
+{
+
+/*!
+ * Settings of the motion-adaptive recursive temporal filter. Per pixel the
+ * filter blends the new value into its history as
+ *     history += alpha * (value - history)
+ * where alpha ramps linearly from `1 - strength` for differences up to
+ * `noise_threshold` to 1 (history dropped) at `motion_threshold`. Static
+ * pixels are averaged over roughly `1 / (1 - strength)` frames while moving
+ * edges follow the scene without trailing.
+ *
+ * Thresholds are in drift-compensated raw counts; multiply by the
+ * temperature slope c1 for the equivalent in °C.
+ */
+struct TemporalFilterSettings {
+  double strength = 0.75;    //!< History weight of static pixels, in [0, 1).
+  int noise_threshold = 8;   //!< Differences up to this count as noise.
+  int motion_threshold = 64; //!< Differences from this on count as motion.
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_TEMPORAL_FILTER_HPP
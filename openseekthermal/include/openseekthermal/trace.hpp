@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_TRACE_HPP
+#define OPENSEEKTHERMAL_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/*!
+ * Event tracing for latency analysis, compiled in with the CMake option
+ * ENABLE_TRACING (defines OPENSEEKTHERMAL_ENABLE_TRACING). Without it the
+ * OPENSEEKTHERMAL_TRACE_* macros expand to nothing and their arguments are
+ * not evaluated.
+ *
+ * Every thread records into its own ring buffer of the most recent
+ * kTraceEventsPerThread events without locks. The buffer is allocated on the
+ * thread's first event; events that fail to allocate it are dropped. writeChromeTrace() may be
+ * called at any time from any thread and exports the buffers as Chrome trace
+ * event JSON, which chrome://tracing and https://ui.perfetto.dev open.
+ *
+ * Event names must outlive the trace: use string literals, or internTraceName()
+ * for names built at runtime.
+ */
+#if OPENSEEKTHERMAL_ENABLE_TRACING
+
+#define OPENSEEKTHERMAL_TRACE_CONCAT_( a, b ) a##b
+#define OPENSEEKTHERMAL_TRACE_CONCAT( a, b ) OPENSEEKTHERMAL_TRACE_CONCAT_( a, b )
+
+//! Record the remainder of the enclosing scope as a duration event.
+#define OPENSEEKTHERMAL_TRACE_SCOPE( name )                                                        \
+  ::openseekthermal::TraceScope OPENSEEKTHERMAL_TRACE_CONCAT( openseekthermal_trace_scope_,       \
+                                                              __LINE__ )( name )
+//! Record a duration event from two std::chrono::steady_clock time points.
+#define OPENSEEKTHERMAL_TRACE_COMPLETE( name, begin, end )                                         \
+  ::openseekthermal::traceComplete( name, begin, end )
+//! Record an instant event with an integer argument.
+#define OPENSEEKTHERMAL_TRACE_INSTANT( name, arg ) ::openseekthermal::traceInstant( name, arg )
+//! Record a sample of the counter track `name`.
+#define OPENSEEKTHERMAL_TRACE_COUNTER( name, value ) ::openseekthermal::traceCounter( name, value )
+
+#else
+
+#define OPENSEEKTHERMAL_TRACE_SCOPE( name )                                                        \
+  do { /* nothing*/                                                                                \
+  } while ( false )
+#define OPENSEEKTHERMAL_TRACE_COMPLETE( name, begin, end )                                         \
+  do { /* nothing*/                                                                                \
+  } while ( false )
+#define OPENSEEKTHERMAL_TRACE_INSTANT( name, arg )                                                 \
+  do { /* nothing*/                                                                                \
+  } while ( false )
+#define OPENSEEKTHERMAL_TRACE_COUNTER( name, value )                                               \
+  do { /* nothing*/                                                                                \
+  } while ( false )
+
+#endif
+
+namespace openseekthermal
+{
+
+//! Capacity of the ring buffer of each thread. Older events are overwritten.
+constexpr size_t kTraceEventsPerThread = 8192;
+
+//! Exited threads whose buffers are kept for export. The buffers of threads
+//! that exited before them are freed.
+constexpr size_t kTraceExitedThreads = 16;
+
+//! Whether the library was built with ENABLE_TRACING.
+constexpr bool isTracingEnabled()
+{
+#if OPENSEEKTHERMAL_ENABLE_TRACING
+  return true;
+#else
+  return false;
+#endif
+}
+
+void traceComplete( const char *name, std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end ) noexcept;
+
+void traceInstant( const char *name, int64_t arg ) noexcept;
+
+void traceCounter( const char *name, int64_t value ) noexcept;
+
+//! Stable copy of `name` for use as an event name. Equal names share one copy.
+const char *internTraceName( const std::string &name );
+
+/*!
+ * Name of the calling thread in the exported trace.
+ * @throws std::bad_alloc if the thread's buffer cannot be allocated.
+ */
+void setTraceThreadName( const std::string &name );
+
+/*!
+ * Write the buffered events of all threads, including the last
+ * kTraceExitedThreads threads that have exited, as Chrome trace event JSON.
+ * Timestamps are steady_clock microseconds. Writes an empty trace if tracing
+ * is not compiled in.
+ */
+void writeChromeTrace( std::ostream &out );
+
+/*!
+ * writeChromeTrace() into the file `path`.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void writeChromeTraceFile( const std::string &path );
+
+//! Discard the events recorded so far.
+void clearTrace() noexcept;
+
+//! Records its lifetime as a duration event, see OPENSEEKTHERMAL_TRACE_SCOPE.
+class TraceScope
+{
+public:
+  explicit TraceScope( const char *name ) noexcept
+      : name_( name ), begin_( std::chrono::steady_clock::now() )
+  {
+  }
+
+  ~TraceScope() { traceComplete( name_, begin_, std::chrono::steady_clock::now() ); }
+
+  TraceScope( const TraceScope & ) = delete;
+  TraceScope &operator=( const TraceScope & ) = delete;
+
+private:
+  const char *name_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+} // namespace openseekthermal
+
+#endif // OPENSEEKTHERMAL_TRACE_HPP
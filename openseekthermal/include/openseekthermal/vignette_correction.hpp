@@ -5,6 +5,7 @@
 #define OPENSEEKTHERMAL_VIGNETTE_CORRECTION_HPP
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace openseekthermal
@@ -34,6 +35,23 @@ public:
   double mean_model = 0.0;
   std::vector<double> coeffs;
 
+  //! Fractional bits of the offset table.
+  static constexpr int kOffsetFractionBits = 8;
+  //! Inclusive bound of the offsets, both signs. Larger offsets saturate every count anyway.
+  static constexpr int32_t kMaxOffset = 0xFFFF << kOffsetFractionBits;
+
+  /*!
+   * Optional precompiled width*height table of `mean_model - model(x, y)` in
+   * Q8 fixed point within `kMaxOffset`, e.g. from a memory-mapped binary
+   * calibration file. The
+   * processing pipeline uses it instead of compiling the polynomial itself.
+   * It must match the model; reset it when changing the coefficients.
+   */
+  std::shared_ptr<const int32_t> offsets;
+
+  //! Compile the polynomial into a width*height offset table (see `offsets`).
+  std::vector<int32_t> computeOffsets() const;
+
   /*!
    * Apply the correction in-place to a width*height host-endian uint16
    * frame buffer. Output is clamped to [0, 0xFFFF].
@@ -0,0 +1,142 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/alarm_monitor.hpp"
+
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+double statistic( const RoiStatistics &stats, AlarmStatistic statistic )
+{
+  switch ( statistic ) {
+  case AlarmStatistic::Max:
+    return stats.max;
+  case AlarmStatistic::Min:
+    return stats.min;
+  case AlarmStatistic::Mean:
+    return stats.mean;
+  }
+  return stats.mean;
+}
+
+bool ruleMet( const AlarmRule &rule, double value, bool was_met )
+{
+  // Once met, the threshold moves by the hysteresis so noise around it does
+  // not toggle the rule.
+  const double hysteresis = was_met ? rule.hysteresis : 0.0;
+  if ( rule.condition == AlarmCondition::Above )
+    return value >= rule.threshold - hysteresis;
+  return value <= rule.threshold + hysteresis;
+}
+
+} // namespace
+
+AlarmMonitor::AlarmMonitor()
+{
+  event_fd_ = ::eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+  if ( event_fd_ < 0 )
+    throw std::system_error( errno, std::generic_category(), "Failed to create alarm eventfd" );
+}
+
+AlarmMonitor::~AlarmMonitor() { ::close( event_fd_ ); }
+
+void AlarmMonitor::setRules( std::vector<AlarmRule> rules )
+{
+  std::lock_guard lock( mutex_ );
+  rules_ = std::move( rules );
+  states_.assign( rules_.size(), RuleState{} );
+  rule_count_.store( rules_.size(), std::memory_order_relaxed );
+}
+
+std::vector<AlarmRule> AlarmMonitor::rules() const
+{
+  std::lock_guard lock( mutex_ );
+  return rules_;
+}
+
+void AlarmMonitor::setCallback( Callback callback )
+{
+  std::lock_guard lock( mutex_ );
+  callback_ = std::move( callback );
+}
+
+void AlarmMonitor::evaluate( const RoiAnalyzer &analyzer,
+                             std::chrono::steady_clock::time_point time )
+{
+  if ( !analyzer.valid() )
+    return;
+  std::vector<AlarmEvent> events;
+  Callback callback;
+  {
+    std::lock_guard lock( mutex_ );
+    for ( size_t i = 0; i < rules_.size(); ++i ) {
+      const AlarmRule &rule = rules_[i];
+      RuleState &state = states_[i];
+      const RoiStatistics stats = rule.roi.width > 0 && rule.roi.height > 0
+                                      ? analyzer.query( rule.roi )
+                                      : analyzer.frameStatistics();
+      if ( stats.pixel_count == 0 )
+        continue;
+      const double value = statistic( stats, rule.statistic );
+      const bool met = ruleMet( rule, value, state.met );
+      if ( met && !state.met )
+        state.met_since = time;
+      state.met = met;
+      const bool active = met && time - state.met_since >= rule.min_duration;
+      if ( active == state.active )
+        continue;
+      state.active = active;
+      events.push_back( { i, rule.name, active, value, time } );
+    }
+    if ( events.empty() )
+      return;
+    for ( const AlarmEvent &event : events ) {
+      if ( pending_.size() == kMaxPendingEvents )
+        pending_.pop_front();
+      pending_.push_back( event );
+    }
+    const uint64_t signal = 1;
+    // Only fails if the counter would overflow, in which case it is readable anyway.
+    [[maybe_unused]] const ssize_t written = ::write( event_fd_, &signal, sizeof( signal ) );
+    callback = callback_;
+  }
+  if ( callback ) {
+    for ( const AlarmEvent &event : events ) callback( event );
+  }
+}
+
+bool AlarmMonitor::active( size_t rule ) const
+{
+  std::lock_guard lock( mutex_ );
+  return rule < states_.size() && states_[rule].active;
+}
+
+std::vector<AlarmEvent> AlarmMonitor::takeEvents()
+{
+  std::lock_guard lock( mutex_ );
+  uint64_t counter;
+  [[maybe_unused]] const ssize_t read = ::read( event_fd_, &counter, sizeof( counter ) );
+  std::vector<AlarmEvent> events( pending_.begin(), pending_.end() );
+  pending_.clear();
+  return events;
+}
+
+void AlarmStage::process( const StageRows &rows )
+{
+  passThroughRows( rows );
+  if ( rows.row_begin == 0 )
+    analyzer_.setOrigin( rows.origin_x, rows.origin_y );
+  analyzer_.addRows( rows.output, rows.width, rows.height, rows.row_begin, rows.row_end );
+  if ( rows.row_end == rows.height )
+    monitor_.evaluate( analyzer_, std::chrono::steady_clock::now() );
+}
+
+} // namespace openseekthermal
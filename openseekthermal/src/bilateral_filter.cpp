@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/detail/bilateral_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace openseekthermal
+{
+
+BilateralFilter::BilateralFilter( const SpatialFilterSettings &settings )
+    : radius_( std::clamp( settings.radius, 1, kMaxRadius ) )
+{
+  const double sigma_spatial = std::max( settings.sigma_spatial, 0.1 );
+  const double sigma_range = std::max( settings.sigma_range, 0.5 );
+  const int taps = 2 * radius_ + 1;
+  spatial_weight_.resize( static_cast<size_t>( taps ) * taps );
+  for ( int dy = -radius_; dy <= radius_; ++dy ) {
+    for ( int dx = -radius_; dx <= radius_; ++dx ) {
+      const double r2 = dx * dx + dy * dy;
+      spatial_weight_[( dy + radius_ ) * taps + dx + radius_] = static_cast<int32_t>(
+          std::lround( 256.0 * std::exp( -r2 / ( 2.0 * sigma_spatial * sigma_spatial ) ) ) );
+    }
+  }
+  // Beyond the largest count difference the table would only grow.
+  range_cutoff_ = static_cast<int>( std::min( std::ceil( 3.0 * sigma_range ), 65536.0 ) );
+  range_weight_.resize( range_cutoff_ + 1 );
+  for ( int d = 0; d < range_cutoff_; ++d ) {
+    range_weight_[d] = static_cast<int32_t>(
+        std::lround( 256.0 * std::exp( -d * d / ( 2.0 * sigma_range * sigma_range ) ) ) );
+  }
+  range_weight_[range_cutoff_] = 0;
+}
+
+void BilateralFilter::filterRows( const uint16_t *src, uint16_t *dst, int width, int height,
+                                  int row_begin, int row_end )
+{
+  const int taps = 2 * radius_ + 1;
+  sum_.resize( width );
+  weight_sum_.resize( width );
+  padded_row_.resize( width + 2 * radius_ );
+  int32_t *__restrict__ sum = sum_.data();
+  int32_t *__restrict__ weight_sum = weight_sum_.data();
+  const int32_t *__restrict__ range_weight = range_weight_.data();
+  const int32_t cutoff = range_cutoff_;
+  for ( int y = row_begin; y < row_end; ++y ) {
+    const uint16_t *__restrict__ center = src + static_cast<size_t>( y ) * width;
+    std::fill( sum_.begin(), sum_.end(), 0 );
+    std::fill( weight_sum_.begin(), weight_sum_.end(), 0 );
+    for ( int dy = -radius_; dy <= radius_; ++dy ) {
+      // Replicate the border: clamp the row and pad the columns so the inner
+      // loop needs no bounds checks.
+      const int sy = std::clamp( y + dy, 0, height - 1 );
+      const uint16_t *row = src + static_cast<size_t>( sy ) * width;
+      std::fill( padded_row_.begin(), padded_row_.begin() + radius_, row[0] );
+      std::copy( row, row + width, padded_row_.begin() + radius_ );
+      std::fill( padded_row_.end() - radius_, padded_row_.end(), row[width - 1] );
+      for ( int dx = -radius_; dx <= radius_; ++dx ) {
+        const int32_t spatial = spatial_weight_[( dy + radius_ ) * taps + dx + radius_];
+        const uint16_t *__restrict__ neighbor = padded_row_.data() + radius_ + dx;
+        for ( int x = 0; x < width; ++x ) {
+          const int32_t v = neighbor[x];
+          const int32_t d = std::min( std::abs( v - static_cast<int32_t>( center[x] ) ), cutoff );
+          const int32_t w = ( spatial * range_weight[d] ) >> 8;
+          sum[x] += w * v;
+          weight_sum[x] += w;
+        }
+      }
+    }
+    // The centre tap has weight 256, so weight_sum is never zero.
+    uint16_t *__restrict__ out = dst + static_cast<size_t>( y ) * width;
+    for ( int x = 0; x < width; ++x ) {
+      out[x] = static_cast<uint16_t>( ( sum[x] + weight_sum[x] / 2 ) / weight_sum[x] );
+    }
+  }
+}
+
+} // namespace openseekthermal
@@ -143,6 +143,14 @@ int requireInt( const Section &sec, const std::string &section_name, const std::
   return v;
 }
 
+double optionalDouble( const Section &sec, const std::string &section_name, const std::string &key,
+                       const std::string &path, double fallback )
+{
+  if ( sec.find( key ) == sec.end() )
+    return fallback;
+  return requireDouble( sec, section_name, key, path );
+}
+
 TemperatureCalibration parseTemperatureSection( const Section &sec, const std::string &path )
 {
   TemperatureCalibration cal;
@@ -187,6 +195,88 @@ VignetteCorrection parseVignetteSection( const Section &sec, const std::string &
   return v;
 }
 
+DistortionCorrection parseDistortionSection( const Section &sec, const std::string &path,
+                                             int expected_width, int expected_height )
+{
+  DistortionCorrection d;
+  d.width = requireInt( sec, "distortion", "width", path );
+  d.height = requireInt( sec, "distortion", "height", path );
+  if ( d.width != expected_width || d.height != expected_height ) {
+    throw std::runtime_error( "Calibration file " + path + " [distortion] size " +
+                              std::to_string( d.width ) + "x" + std::to_string( d.height ) +
+                              " does not match camera " + std::to_string( expected_width ) + "x" +
+                              std::to_string( expected_height ) );
+  }
+  d.fx = requireDouble( sec, "distortion", "fx", path );
+  d.fy = requireDouble( sec, "distortion", "fy", path );
+  d.cx = requireDouble( sec, "distortion", "cx", path );
+  d.cy = requireDouble( sec, "distortion", "cy", path );
+  d.k1 = requireDouble( sec, "distortion", "k1", path );
+  d.k2 = optionalDouble( sec, "distortion", "k2", path, 0.0 );
+  d.k3 = optionalDouble( sec, "distortion", "k3", path, 0.0 );
+  d.p1 = optionalDouble( sec, "distortion", "p1", path, 0.0 );
+  d.p2 = optionalDouble( sec, "distortion", "p2", path, 0.0 );
+  if ( !( d.fx > 0.0 ) || !( d.fy > 0.0 ) ) {
+    throw std::runtime_error( "Calibration file " + path +
+                              " [distortion] focal lengths must be positive" );
+  }
+  return d;
+}
+
+std::vector<double> parseDoubleList( const Section &sec, const std::string &section_name,
+                                     const std::string &key, const std::string &path,
+                                     size_t expected_count )
+{
+  auto it = sec.find( key );
+  if ( it == sec.end() ) {
+    throw std::runtime_error( "Calibration file " + path + " [" + section_name +
+                              "] missing required key '" + key + "'" );
+  }
+  std::vector<double> values;
+  values.reserve( expected_count );
+  const std::string &s = it->second;
+  const char *p = s.data();
+  const char *last = s.data() + s.size();
+  while ( true ) {
+    while ( p != last && std::isspace( static_cast<unsigned char>( *p ) ) ) ++p;
+    if ( p == last )
+      break;
+    double v;
+    auto [ptr, ec] = std::from_chars( p, last, v );
+    if ( ec != std::errc() ||
+         ( ptr != last && !std::isspace( static_cast<unsigned char>( *ptr ) ) ) ) {
+      throw std::runtime_error( "Calibration file " + path + " [" + section_name + "] key '" +
+                                key + "' has an invalid value at offset " +
+                                std::to_string( p - s.data() ) );
+    }
+    values.push_back( v );
+    p = ptr;
+  }
+  if ( values.size() != expected_count ) {
+    throw std::runtime_error( "Calibration file " + path + " [" + section_name + "] key '" + key +
+                              "' has " + std::to_string( values.size() ) + " values, expected " +
+                              std::to_string( expected_count ) );
+  }
+  return values;
+}
+
+NonUniformityCorrection parseNonUniformitySection( const Section &sec, const std::string &path,
+                                                   int expected_width, int expected_height )
+{
+  const int width = requireInt( sec, "non_uniformity", "width", path );
+  const int height = requireInt( sec, "non_uniformity", "height", path );
+  if ( width != expected_width || height != expected_height ) {
+    throw std::runtime_error( "Calibration file " + path + " [non_uniformity] size " +
+                              std::to_string( width ) + "x" + std::to_string( height ) +
+                              " does not match camera " + std::to_string( expected_width ) + "x" +
+                              std::to_string( expected_height ) );
+  }
+  const size_t count = static_cast<size_t>( width ) * height;
+  return NonUniformityCorrection( width, height,
+                                  parseDoubleList( sec, "non_uniformity", "gain", path, count ),
+                                  parseDoubleList( sec, "non_uniformity", "offset", path, count ) );
+}
+
 DeadPixelMask parseDeadPixelsSection( const Section &sec, const std::string &path,
                                       int expected_width, int expected_height )
 {
@@ -250,6 +340,40 @@ void writeVignetteSection( std::ostream &out, const VignetteCorrection &v )
   out << "\n";
 }
 
+void writeDistortionSection( std::ostream &out, const DistortionCorrection &d )
+{
+  out << "[distortion]\n";
+  out << "width = " << d.width << "\n";
+  out << "height = " << d.height << "\n";
+  out << std::setprecision( 9 );
+  out << "fx = " << d.fx << "\n";
+  out << "fy = " << d.fy << "\n";
+  out << "cx = " << d.cx << "\n";
+  out << "cy = " << d.cy << "\n";
+  out << "k1 = " << d.k1 << "\n";
+  out << "k2 = " << d.k2 << "\n";
+  out << "k3 = " << d.k3 << "\n";
+  out << "p1 = " << d.p1 << "\n";
+  out << "p2 = " << d.p2 << "\n";
+}
+
+void writeNonUniformitySection( std::ostream &out, const NonUniformityCorrection &nuc )
+{
+  out << "[non_uniformity]\n";
+  out << "width = " << nuc.width() << "\n";
+  out << "height = " << nuc.height() << "\n";
+  // One line per table, like [dead_pixels]. Ten significant digits keep the
+  // Q12 values exact over the whole offset range.
+  const size_t count = static_cast<size_t>( nuc.width() ) * nuc.height();
+  out << std::setprecision( 10 );
+  out << "gain =";
+  for ( size_t i = 0; i < count; ++i ) out << " " << nuc.gain( i );
+  out << "\n";
+  out << "offset =";
+  for ( size_t i = 0; i < count; ++i ) out << " " << nuc.offset( i );
+  out << "\n";
+}
+
 void writeDeadPixelsSection( std::ostream &out, const DeadPixelMask &mask )
 {
   out << "[dead_pixels]\n";
@@ -274,6 +398,8 @@ void writeDeadPixelsSection( std::ostream &out, const DeadPixelMask &mask )
 CameraCalibration loadCameraCalibration( const std::filesystem::path &path, int expected_width,
                                          int expected_height )
 {
+  if ( isBinaryCameraCalibration( path ) )
+    return loadCameraCalibrationBinary( path, expected_width, expected_height );
   std::ifstream in( path );
   if ( !in ) {
     throw std::runtime_error( "Could not open calibration: " + path.string() );
@@ -290,6 +416,14 @@ CameraCalibration loadCameraCalibration( const std::filesystem::path &path, int
   if ( auto it = parsed.sections.find( "dead_pixels" ); it != parsed.sections.end() ) {
     cal.dead_pixels = parseDeadPixelsSection( it->second, path_str, expected_width, expected_height );
   }
+  if ( auto it = parsed.sections.find( "non_uniformity" ); it != parsed.sections.end() ) {
+    cal.non_uniformity =
+        parseNonUniformitySection( it->second, path_str, expected_width, expected_height );
+  }
+  if ( auto it = parsed.sections.find( "distortion" ); it != parsed.sections.end() ) {
+    cal.distortion =
+        parseDistortionSection( it->second, path_str, expected_width, expected_height );
+  }
   return cal;
 }
 
@@ -318,6 +452,14 @@ void saveCameraCalibration( const std::filesystem::path &path, const CameraCalib
     writeDeadPixelsSection( out, *cal.dead_pixels );
     out << "\n";
   }
+  if ( cal.non_uniformity ) {
+    writeNonUniformitySection( out, *cal.non_uniformity );
+    out << "\n";
+  }
+  if ( cal.distortion ) {
+    writeDistortionSection( out, *cal.distortion );
+    out << "\n";
+  }
 }
 
 } // namespace openseekthermal
@@ -0,0 +1,575 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Binary calibration container. Layout (little-endian, version 1):
+//
+//   FileHeader      64 bytes
+//   SectionEntry    32 bytes each, `section_count` entries
+//   sections        each at a multiple of 64 bytes
+//
+// Every section has a four character id and a CRC-32; the section table has
+// its own CRC-32 in the header. Sections hold the runtime representation of
+// the calibration, per-pixel tables included, so loading maps the file and
+// points into it instead of parsing. Unknown section ids are skipped, so
+// sections can be added without a version change.
+
+#include "openseekthermal/camera_calibration.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+constexpr char kMagic[8] = { 'O', 'S', 'T', 'C', 'A', 'L', 'B', '\0' };
+constexpr uint32_t kVersion = 1;
+constexpr size_t kSectionAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  //! Frame size of the per-pixel sections; 0 if there are none.
+  uint32_t width;
+  uint32_t height;
+  uint32_t section_count;
+  //! CRC-32 of the section table.
+  uint32_t table_crc;
+  uint8_t reserved[32];
+};
+static_assert( sizeof( FileHeader ) == 64 );
+
+struct SectionEntry {
+  char id[4];
+  uint32_t crc;
+  uint64_t offset;
+  uint64_t size;
+  uint64_t reserved;
+};
+static_assert( sizeof( SectionEntry ) == 32 );
+
+constexpr char kTemperatureId[4] = { 'T', 'E', 'M', 'P' };
+constexpr char kVignetteId[4] = { 'V', 'I', 'G', 'N' };
+//! Q8 VignetteCorrection::offsets, width*height int32.
+constexpr char kVignetteOffsetsId[4] = { 'V', 'O', 'F', 'S' };
+//! DeadPixelsSection followed by the DeadPixelEntry array.
+constexpr char kDeadPixelsId[4] = { 'D', 'E', 'A', 'D' };
+constexpr char kDistortionId[4] = { 'D', 'I', 'S', 'T' };
+//! NonUniformitySection followed by the Q12 gain and offset tables,
+//! width*height int32 each.
+constexpr char kNonUniformityId[4] = { 'N', 'U', 'C', 'G' };
+
+struct TemperatureSection {
+  double c0;
+  double c1;
+  double pad_ref;
+};
+static_assert( sizeof( TemperatureSection ) == 24 );
+
+//! Largest vignette degree accepted from a file; the fits use far fewer terms.
+constexpr int32_t kMaxVignetteDegree = 32;
+
+//! Followed by `degree + 1` doubles of coefficients.
+struct VignetteSection {
+  int32_t width;
+  int32_t height;
+  int32_t degree;
+  int32_t reserved;
+  double cx;
+  double cy;
+  double r2_max;
+  double mean_model;
+};
+static_assert( sizeof( VignetteSection ) == 48 );
+
+struct DeadPixelsSection {
+  uint32_t count;
+  uint32_t reserved[3];
+};
+static_assert( sizeof( DeadPixelsSection ) == 16 );
+// The entries are used in place, so their layout is part of the format.
+static_assert( std::is_trivially_copyable_v<DeadPixelEntry> && sizeof( DeadPixelEntry ) == 48 &&
+               offsetof( DeadPixelEntry, neighbor_count ) == 4 &&
+               offsetof( DeadPixelEntry, neighbors ) == 8 &&
+               offsetof( DeadPixelEntry, weights ) == 40 );
+
+struct NonUniformitySection {
+  int32_t width;
+  int32_t height;
+  int32_t reserved[2];
+};
+static_assert( sizeof( NonUniformitySection ) == 16 );
+
+struct DistortionSection {
+  int32_t width;
+  int32_t height;
+  double fx;
+  double fy;
+  double cx;
+  double cy;
+  double k1;
+  double k2;
+  double k3;
+  double p1;
+  double p2;
+};
+static_assert( sizeof( DistortionSection ) == 80 );
+
+constexpr bool kLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+uint32_t crc32( const uint8_t *data, size_t size )
+{
+  static const std::array<uint32_t, 256> table = []() {
+    std::array<uint32_t, 256> result{};
+    for ( uint32_t i = 0; i < 256; ++i ) {
+      uint32_t c = i;
+      for ( int k = 0; k < 8; ++k ) c = ( c & 1 ) ? 0xEDB88320u ^ ( c >> 1 ) : c >> 1;
+      result[i] = c;
+    }
+    return result;
+  }();
+  uint32_t crc = 0xFFFFFFFFu;
+  for ( size_t i = 0; i < size; ++i ) crc = table[( crc ^ data[i] ) & 0xFF] ^ ( crc >> 8 );
+  return crc ^ 0xFFFFFFFFu;
+}
+
+//! Read-only mapping of a whole file, unmapped on destruction.
+class MappedFile
+{
+public:
+  explicit MappedFile( const std::string &path )
+  {
+    const int fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if ( fd < 0 )
+      throw std::system_error( errno, std::generic_category(),
+                               "Could not open calibration: " + path );
+    struct stat st {
+    };
+    if ( ::fstat( fd, &st ) != 0 ) {
+      const int error = errno;
+      ::close( fd );
+      throw std::system_error( error, std::generic_category(),
+                               "Could not stat calibration: " + path );
+    }
+    size_ = static_cast<size_t>( st.st_size );
+    if ( size_ > 0 ) {
+      void *data = ::mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( data == MAP_FAILED ) {
+        const int error = errno;
+        ::close( fd );
+        throw std::system_error( error, std::generic_category(),
+                                 "Could not map calibration: " + path );
+      }
+      data_ = static_cast<const uint8_t *>( data );
+    }
+    ::close( fd );
+  }
+
+  ~MappedFile()
+  {
+    if ( data_ != nullptr )
+      ::munmap( const_cast<uint8_t *>( data_ ), size_ );
+  }
+
+  MappedFile( const MappedFile & ) = delete;
+  MappedFile &operator=( const MappedFile & ) = delete;
+
+  const uint8_t *data() const noexcept { return data_; }
+
+  size_t size() const noexcept { return size_; }
+
+private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+struct SectionView {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+};
+
+void checkSize( const SectionView &section, size_t size, const char *name, const std::string &path )
+{
+  if ( section.size != size ) {
+    throw std::runtime_error( "Calibration file " + path + ": " + name + " section has size " +
+                              std::to_string( section.size ) + ", expected " +
+                              std::to_string( size ) );
+  }
+}
+
+void checkFrameSize( int width, int height, int expected_width, int expected_height,
+                     const char *name, const std::string &path )
+{
+  if ( width != expected_width || height != expected_height ) {
+    throw std::runtime_error( "Calibration file " + path + " " + name + " size " +
+                              std::to_string( width ) + "x" + std::to_string( height ) +
+                              " does not match camera " + std::to_string( expected_width ) + "x" +
+                              std::to_string( expected_height ) );
+  }
+}
+
+//! Entries are used without copying, so check everything applyRows() relies on.
+void validateDeadPixelEntries( const DeadPixelEntry *entries, size_t count, size_t pixel_count,
+                               const std::string &path )
+{
+  for ( size_t i = 0; i < count; ++i ) {
+    const DeadPixelEntry &entry = entries[i];
+    bool valid = entry.index < pixel_count && entry.neighbor_count <= 8 &&
+                 ( i == 0 || entries[i - 1].index < entry.index );
+    for ( uint8_t n = 0; valid && n < entry.neighbor_count; ++n )
+      valid = entry.neighbors[n] < pixel_count && entry.weights[n] > 0;
+    if ( !valid ) {
+      throw std::runtime_error( "Calibration file " + path + ": invalid dead pixel entry " +
+                                std::to_string( i ) );
+    }
+  }
+}
+
+//! The tables are used without copying; out of range values could overflow
+//! the fixed-point multiply-add.
+void validateNonUniformityTables( const int32_t *gain, const int32_t *offset, size_t pixel_count,
+                                  const std::string &path )
+{
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    if ( gain[i] < 0 || gain[i] >= NonUniformityCorrection::kMaxGain ||
+         offset[i] < -NonUniformityCorrection::kMaxOffset ||
+         offset[i] > NonUniformityCorrection::kMaxOffset ) {
+      throw std::runtime_error( "Calibration file " + path +
+                                ": non-uniformity value out of range at pixel " +
+                                std::to_string( i ) );
+    }
+  }
+}
+
+//! Reject vignette offsets the Q8 vignette stage could overflow on.
+void validateVignetteOffsets( const int32_t *offset, size_t pixel_count, const std::string &path )
+{
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    if ( offset[i] < -VignetteCorrection::kMaxOffset || offset[i] > VignetteCorrection::kMaxOffset )
+      throw std::runtime_error( "Calibration file " + path +
+                                ": vignette offset out of range at pixel " + std::to_string( i ) );
+  }
+}
+
+//! Append `size` bytes as a section at the next aligned offset of `file`.
+void appendSection( std::vector<uint8_t> &file, std::vector<SectionEntry> &table, const char *id,
+                    const void *data, size_t size )
+{
+  const size_t offset =
+      ( file.size() + kSectionAlignment - 1 ) / kSectionAlignment * kSectionAlignment;
+  file.resize( offset + size, 0 );
+  if ( size > 0 )
+    std::memcpy( file.data() + offset, data, size );
+  SectionEntry entry{};
+  std::memcpy( entry.id, id, sizeof( entry.id ) );
+  entry.crc = crc32( file.data() + offset, size );
+  entry.offset = offset;
+  entry.size = size;
+  table.push_back( entry );
+}
+
+template<typename T>
+void appendBytes( std::vector<uint8_t> &buffer, const T &value )
+{
+  const auto *bytes = reinterpret_cast<const uint8_t *>( &value );
+  buffer.insert( buffer.end(), bytes, bytes + sizeof( T ) );
+}
+
+} // namespace
+
+bool isBinaryCameraCalibration( const std::filesystem::path &path )
+{
+  std::ifstream in( path, std::ios::binary );
+  char magic[sizeof( kMagic )];
+  return in.read( magic, sizeof( magic ) ) && std::memcmp( magic, kMagic, sizeof( kMagic ) ) == 0;
+}
+
+CameraCalibration loadCameraCalibrationBinary( const std::filesystem::path &path,
+                                               int expected_width, int expected_height )
+{
+  const std::string path_str = path.string();
+  if ( !kLittleEndian )
+    throw std::runtime_error( "Binary calibration files require a little-endian host" );
+  const auto file = std::make_shared<const MappedFile>( path_str );
+  const uint8_t *data = file->data();
+  const size_t size = file->size();
+
+  FileHeader header;
+  if ( size < sizeof( header ) )
+    throw std::runtime_error( "Calibration file " + path_str + " is truncated" );
+  std::memcpy( &header, data, sizeof( header ) );
+  if ( std::memcmp( header.magic, kMagic, sizeof( kMagic ) ) != 0 )
+    throw std::runtime_error( "Calibration file " + path_str + " is not a binary calibration" );
+  if ( header.version != kVersion || header.header_size != sizeof( FileHeader ) ) {
+    throw std::runtime_error( "Calibration file " + path_str + " has unsupported version " +
+                              std::to_string( header.version ) );
+  }
+  const size_t table_size = static_cast<size_t>( header.section_count ) * sizeof( SectionEntry );
+  if ( header.section_count > ( size - sizeof( header ) ) / sizeof( SectionEntry ) )
+    throw std::runtime_error( "Calibration file " + path_str + " is truncated" );
+  const uint8_t *table = data + sizeof( header );
+  if ( crc32( table, table_size ) != header.table_crc )
+    throw std::runtime_error( "Calibration file " + path_str +
+                              ": section table checksum mismatch" );
+
+  const auto find = [&]( const char *id ) -> std::optional<SectionView> {
+    for ( uint32_t i = 0; i < header.section_count; ++i ) {
+      SectionEntry entry;
+      std::memcpy( &entry, table + i * sizeof( SectionEntry ), sizeof( entry ) );
+      if ( std::memcmp( entry.id, id, sizeof( entry.id ) ) != 0 )
+        continue;
+      const std::string name( id, sizeof( entry.id ) );
+      if ( entry.offset % kSectionAlignment != 0 || entry.offset > size ||
+           entry.size > size - entry.offset ) {
+        throw std::runtime_error( "Calibration file " + path_str + ": section " + name +
+                                  " is out of bounds" );
+      }
+      const SectionView view{ data + entry.offset, static_cast<size_t>( entry.size ) };
+      if ( crc32( view.data, view.size ) != entry.crc ) {
+        throw std::runtime_error( "Calibration file " + path_str + ": section " + name +
+                                  " checksum mismatch" );
+      }
+      return view;
+    }
+    return std::nullopt;
+  };
+
+  CameraCalibration cal;
+  if ( auto section = find( kTemperatureId ) ) {
+    checkSize( *section, sizeof( TemperatureSection ), "temperature", path_str );
+    TemperatureSection temperature;
+    std::memcpy( &temperature, section->data, sizeof( temperature ) );
+    cal.temperature = TemperatureCalibration();
+    cal.temperature->c0 = temperature.c0;
+    cal.temperature->c1 = temperature.c1;
+    cal.temperature->pad_ref = temperature.pad_ref;
+  }
+  if ( auto section = find( kVignetteId ) ) {
+    VignetteSection params;
+    if ( section->size < sizeof( params ) )
+      checkSize( *section, sizeof( params ), "vignette", path_str );
+    std::memcpy( &params, section->data, sizeof( params ) );
+    if ( params.degree < 0 || params.degree > kMaxVignetteDegree )
+      throw std::runtime_error( "Calibration file " + path_str + ": invalid vignette degree " +
+                                std::to_string( params.degree ) );
+    checkSize( *section,
+               sizeof( params ) + ( static_cast<size_t>( params.degree ) + 1 ) * sizeof( double ),
+               "vignette", path_str );
+    checkFrameSize( params.width, params.height, expected_width, expected_height, "vignette",
+                    path_str );
+    VignetteCorrection &v = cal.vignette.emplace();
+    v.width = params.width;
+    v.height = params.height;
+    v.cx = params.cx;
+    v.cy = params.cy;
+    v.r2_max = params.r2_max;
+    v.mean_model = params.mean_model;
+    v.degree = params.degree;
+    v.coeffs.resize( params.degree + 1 );
+    std::memcpy( v.coeffs.data(), section->data + sizeof( params ),
+                 v.coeffs.size() * sizeof( double ) );
+    if ( auto offsets = find( kVignetteOffsetsId ) ) {
+      const size_t pixel_count = static_cast<size_t>( v.width ) * v.height;
+      checkSize( *offsets, pixel_count * sizeof( int32_t ), "vignette offsets", path_str );
+      const auto *table = reinterpret_cast<const int32_t *>( offsets->data );
+      validateVignetteOffsets( table, pixel_count, path_str );
+      v.offsets = std::shared_ptr<const int32_t>( file, table );
+    }
+  }
+  if ( auto section = find( kDeadPixelsId ) ) {
+    if ( header.width == 0 || header.height == 0 )
+      throw std::runtime_error( "Calibration file " + path_str + ": dead pixels without a size" );
+    checkFrameSize( header.width, header.height, expected_width, expected_height, "dead pixel",
+                    path_str );
+    DeadPixelsSection params;
+    if ( section->size < sizeof( params ) )
+      checkSize( *section, sizeof( params ), "dead pixel", path_str );
+    std::memcpy( &params, section->data, sizeof( params ) );
+    checkSize( *section, sizeof( params ) + params.count * sizeof( DeadPixelEntry ), "dead pixel",
+               path_str );
+    const auto *entries =
+        reinterpret_cast<const DeadPixelEntry *>( section->data + sizeof( params ) );
+    validateDeadPixelEntries( entries, params.count,
+                              static_cast<size_t>( header.width ) * header.height, path_str );
+    cal.dead_pixels = DeadPixelMask( header.width, header.height,
+                                     std::shared_ptr<const DeadPixelEntry>( file, entries ),
+                                     params.count );
+  }
+  if ( auto section = find( kNonUniformityId ) ) {
+    NonUniformitySection params;
+    if ( section->size < sizeof( params ) )
+      checkSize( *section, sizeof( params ), "non-uniformity", path_str );
+    std::memcpy( &params, section->data, sizeof( params ) );
+    checkFrameSize( params.width, params.height, expected_width, expected_height,
+                    "non-uniformity", path_str );
+    const size_t pixel_count = static_cast<size_t>( params.width ) * params.height;
+    checkSize( *section, sizeof( params ) + 2 * pixel_count * sizeof( int32_t ), "non-uniformity",
+               path_str );
+    const auto *gain = reinterpret_cast<const int32_t *>( section->data + sizeof( params ) );
+    const int32_t *offset = gain + pixel_count;
+    validateNonUniformityTables( gain, offset, pixel_count, path_str );
+    cal.non_uniformity = NonUniformityCorrection( params.width, params.height,
+                                                  std::shared_ptr<const int32_t>( file, gain ),
+                                                  std::shared_ptr<const int32_t>( file, offset ) );
+  }
+  if ( auto section = find( kDistortionId ) ) {
+    checkSize( *section, sizeof( DistortionSection ), "distortion", path_str );
+    DistortionSection params;
+    std::memcpy( &params, section->data, sizeof( params ) );
+    checkFrameSize( params.width, params.height, expected_width, expected_height, "distortion",
+                    path_str );
+    DistortionCorrection &d = cal.distortion.emplace();
+    d.width = params.width;
+    d.height = params.height;
+    d.fx = params.fx;
+    d.fy = params.fy;
+    d.cx = params.cx;
+    d.cy = params.cy;
+    d.k1 = params.k1;
+    d.k2 = params.k2;
+    d.k3 = params.k3;
+    d.p1 = params.p1;
+    d.p2 = params.p2;
+  }
+  return cal;
+}
+
+void saveCameraCalibrationBinary( const std::filesystem::path &path, const CameraCalibration &cal )
+{
+  if ( !kLittleEndian )
+    throw std::runtime_error( "Binary calibration files require a little-endian host" );
+  int width = 0;
+  int height = 0;
+  const auto useSize = [&width, &height]( int w, int h ) {
+    if ( width != 0 && ( w != width || h != height ) )
+      throw std::invalid_argument( "Calibration sections have different frame sizes" );
+    width = w;
+    height = h;
+  };
+  if ( cal.vignette )
+    useSize( cal.vignette->width, cal.vignette->height );
+  if ( cal.dead_pixels )
+    useSize( cal.dead_pixels->width(), cal.dead_pixels->height() );
+  if ( cal.distortion )
+    useSize( cal.distortion->width, cal.distortion->height );
+  if ( cal.non_uniformity )
+    useSize( cal.non_uniformity->width(), cal.non_uniformity->height() );
+
+  std::vector<uint8_t> file( sizeof( FileHeader ) );
+  std::vector<SectionEntry> table;
+  // Sections are appended behind a placeholder of the final table size.
+  const size_t section_count = ( cal.temperature ? 1 : 0 ) + ( cal.vignette ? 2 : 0 ) +
+                               ( cal.dead_pixels ? 1 : 0 ) + ( cal.distortion ? 1 : 0 ) +
+                               ( cal.non_uniformity && cal.non_uniformity->gainTable() ? 1 : 0 );
+  file.resize( file.size() + section_count * sizeof( SectionEntry ), 0 );
+
+  if ( cal.temperature ) {
+    const TemperatureSection section{ cal.temperature->c0, cal.temperature->c1,
+                                      cal.temperature->pad_ref };
+    appendSection( file, table, kTemperatureId, &section, sizeof( section ) );
+  }
+  if ( cal.vignette ) {
+    const VignetteCorrection &v = *cal.vignette;
+    VignetteSection params{};
+    params.width = v.width;
+    params.height = v.height;
+    params.degree = static_cast<int32_t>( v.coeffs.size() ) - 1;
+    params.cx = v.cx;
+    params.cy = v.cy;
+    params.r2_max = v.r2_max;
+    params.mean_model = v.mean_model;
+    std::vector<uint8_t> buffer;
+    appendBytes( buffer, params );
+    for ( double c : v.coeffs ) appendBytes( buffer, c );
+    appendSection( file, table, kVignetteId, buffer.data(), buffer.size() );
+    const size_t pixel_count = static_cast<size_t>( v.width ) * v.height;
+    if ( v.offsets != nullptr ) {
+      appendSection( file, table, kVignetteOffsetsId, v.offsets.get(),
+                     pixel_count * sizeof( int32_t ) );
+    } else {
+      const std::vector<int32_t> offsets = v.computeOffsets();
+      appendSection( file, table, kVignetteOffsetsId, offsets.data(),
+                     offsets.size() * sizeof( int32_t ) );
+    }
+  }
+  if ( cal.dead_pixels ) {
+    DeadPixelsSection params{};
+    params.count = static_cast<uint32_t>( cal.dead_pixels->deadPixelCount() );
+    std::vector<uint8_t> buffer;
+    appendBytes( buffer, params );
+    // Field by field so the padding is written as zeros.
+    for ( const DeadPixelEntry &entry : cal.dead_pixels->entries() ) {
+      uint8_t bytes[sizeof( DeadPixelEntry )] = {};
+      std::memcpy( bytes + offsetof( DeadPixelEntry, index ), &entry.index, sizeof( entry.index ) );
+      bytes[offsetof( DeadPixelEntry, neighbor_count )] = entry.neighbor_count;
+      std::memcpy( bytes + offsetof( DeadPixelEntry, neighbors ), entry.neighbors,
+                   sizeof( entry.neighbors ) );
+      std::memcpy( bytes + offsetof( DeadPixelEntry, weights ), entry.weights,
+                   sizeof( entry.weights ) );
+      buffer.insert( buffer.end(), bytes, bytes + sizeof( bytes ) );
+    }
+    appendSection( file, table, kDeadPixelsId, buffer.data(), buffer.size() );
+  }
+  if ( cal.non_uniformity && cal.non_uniformity->gainTable() != nullptr ) {
+    const NonUniformityCorrection &nuc = *cal.non_uniformity;
+    NonUniformitySection params{};
+    params.width = nuc.width();
+    params.height = nuc.height();
+    const size_t table_size = static_cast<size_t>( nuc.width() ) * nuc.height() * sizeof( int32_t );
+    std::vector<uint8_t> buffer;
+    appendBytes( buffer, params );
+    const auto *gain = reinterpret_cast<const uint8_t *>( nuc.gainTable() );
+    const auto *offset = reinterpret_cast<const uint8_t *>( nuc.offsetTable() );
+    buffer.insert( buffer.end(), gain, gain + table_size );
+    buffer.insert( buffer.end(), offset, offset + table_size );
+    appendSection( file, table, kNonUniformityId, buffer.data(), buffer.size() );
+  }
+  if ( cal.distortion ) {
+    const DistortionCorrection &d = *cal.distortion;
+    const DistortionSection section{ d.width, d.height, d.fx, d.fy, d.cx, d.cy,
+                                     d.k1,    d.k2,     d.k3, d.p1, d.p2 };
+    appendSection( file, table, kDistortionId, &section, sizeof( section ) );
+  }
+
+  std::memcpy( file.data() + sizeof( FileHeader ), table.data(),
+               table.size() * sizeof( SectionEntry ) );
+  FileHeader header{};
+  std::memcpy( header.magic, kMagic, sizeof( kMagic ) );
+  header.version = kVersion;
+  header.header_size = sizeof( FileHeader );
+  header.width = static_cast<uint32_t>( width );
+  header.height = static_cast<uint32_t>( height );
+  header.section_count = static_cast<uint32_t>( table.size() );
+  header.table_crc =
+      crc32( file.data() + sizeof( FileHeader ), table.size() * sizeof( SectionEntry ) );
+  std::memcpy( file.data(), &header, sizeof( header ) );
+
+  std::ofstream out( path, std::ios::binary | std::ios::trunc );
+  if ( !out ) {
+    throw std::runtime_error( "Could not open calibration for writing: " + path.string() );
+  }
+  out.write( reinterpret_cast<const char *>( file.data() ),
+             static_cast<std::streamsize>( file.size() ) );
+  if ( !out ) {
+    throw std::runtime_error( "Could not write calibration: " + path.string() );
+  }
+}
+
+} // namespace openseekthermal
@@ -3,23 +3,147 @@
 
 #include "openseekthermal/detail/cameras/seek_thermal_camera.hpp"
 #include "openseekthermal/detail/exceptions.hpp"
+#include "openseekthermal/detail/usb/device_traits.hpp"
+#include "openseekthermal/trace.hpp"
 #include <libusb-1.0/libusb.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include "../helpers.hpp"
 #include "../logging.hpp"
-#include "../timer.hpp"
 
 namespace openseekthermal
 {
 
+namespace
+{
+
+template<typename Traits>
+size_t extractKernel( SentinelMap &map, const unsigned char *data, unsigned char *frame,
+                      bool learn, const int32_t *column_offset )
+{
+  return map.extract<Traits::kWidth, Traits::kHeight, Traits::kRowStride>(
+      reinterpret_cast<const uint16_t *>( data ), reinterpret_cast<uint16_t *>( frame ), learn,
+      column_offset );
+}
+
+template<typename Traits>
+double padDriftSignalKernel( const unsigned char *transfer_buffer, size_t transfer_buffer_size )
+{
+  constexpr size_t kRequiredSize =
+      Traits::kFrameHeaderSize + static_cast<size_t>( Traits::kHeight ) * Traits::kRowStep;
+  if ( transfer_buffer_size < kRequiredSize ) {
+    return 0.0;
+  }
+  const auto *body_u16 =
+      reinterpret_cast<const uint16_t *>( transfer_buffer + Traits::kFrameHeaderSize );
+  uint64_t sum = 0;
+  int count = 0;
+  for ( int y = 0; y < Traits::kHeight; ++y ) {
+    // Skip sentinels (0 / 0xFFFF). They appear in some startup/test transfers
+    // and would skew the mean.
+    const uint16_t v = le16toh( body_u16[y * Traits::kRowStride + Traits::kWidth] );
+    if ( v == 0 || v == 0xFFFF )
+      continue;
+    sum += v;
+    ++count;
+  }
+  return count > 0 ? static_cast<double>( sum ) / count : 0.0;
+}
+
+//! Allocate `*data` if the caller did not provide a buffer. Returns false if
+//! the provided buffer is smaller than `required` bytes.
+template<typename T>
+bool prepareOutputBuffer( T **data, size_t &size, size_t required )
+{
+  if ( data == nullptr )
+    return true;
+  if ( *data == nullptr ) {
+    size = required;
+    *data = new T[required / sizeof( T )];
+    return true;
+  }
+  return size >= required;
+}
+
+//! `sum[i] += frame[i]`. Written as a plain widening loop so it vectorizes.
+void accumulateFrame( const uint16_t *__restrict__ frame, uint32_t *__restrict__ sum,
+                      size_t count )
+{
+  for ( size_t i = 0; i < count; ++i ) sum[i] += frame[i];
+}
+
+//! Rounded `sum[i] / frames`.
+void averageFrames( const uint32_t *__restrict__ sum, uint16_t *__restrict__ frame, size_t count,
+                    uint32_t frames )
+{
+  const uint32_t half = frames / 2;
+  for ( size_t i = 0; i < count; ++i ) {
+    frame[i] = static_cast<uint16_t>( ( sum[i] + half ) / frames );
+  }
+}
+
+//! Re-express a sum of `frames` frames taken with the additive per-pixel
+//! offset `from` as if it had been taken with `to` (nullptr: no offset).
+void rebaseIntegrationSum( uint32_t *sum, const int32_t *from, const int32_t *to, size_t count,
+                           uint32_t frames )
+{
+  const int64_t max = int64_t{ 0xFFFF } * frames;
+  for ( size_t i = 0; i < count; ++i ) {
+    const int64_t delta = ( from != nullptr ? from[i] : 0 ) - ( to != nullptr ? to[i] : 0 );
+    sum[i] = static_cast<uint32_t>( std::clamp<int64_t>( sum[i] + delta * frames, 0, max ) );
+  }
+}
+
+//! Mean of each `Factor`x`Factor` block of `Factor` rows of `input`, `stride`
+//! elements apart, into the `width` pixels of `output`. Integer means are
+//! rounded.
+template<int Factor, typename T>
+void binRow( const T *__restrict__ input, size_t stride, int width, T *__restrict__ output )
+{
+  using Sum = std::conditional_t<std::is_floating_point_v<T>, T, uint32_t>;
+  constexpr Sum area = Factor * Factor;
+  for ( int x = 0; x < width; ++x ) {
+    const T *block = input + static_cast<size_t>( x ) * Factor;
+    Sum sum = 0;
+    for ( int dy = 0; dy < Factor; ++dy ) {
+      for ( int dx = 0; dx < Factor; ++dx ) sum += block[dy * stride + dx];
+    }
+    if constexpr ( std::is_floating_point_v<T> )
+      output[x] = sum / area;
+    else
+      output[x] = static_cast<T>( ( sum + area / 2 ) / area );
+  }
+}
+
+template<typename T>
+void binRow( const T *input, size_t stride, int factor, int width, T *output )
+{
+  switch ( factor ) {
+  case 2:
+    binRow<2>( input, stride, width, output );
+    break;
+  case 4:
+    binRow<4>( input, stride, width, output );
+    break;
+  default:
+    std::copy( input, input + width, output );
+    break;
+  }
+}
+
+} // namespace
+
 SeekThermalCamera::SeekThermalCamera( SeekDevice device, libusb_context *usb_context ) noexcept
-    : device_( std::move( device ) ), usb_context_( usb_context )
+    : device_( std::move( device ) ), kernels_( selectFrameKernels( device_.type ) ),
+      pipeline_( kernels_.width, kernels_.height ), processing_( pipeline_, metrics_ ),
+      usb_context_( usb_context )
 {
   // Default to the USB-advertised serial (Nano 300). Products that don't expose
   // it over USB overwrite this from factory data in setupCamera().
@@ -36,9 +160,48 @@ SeekThermalCamera::~SeekThermalCamera()
   }
 }
 
+SeekThermalCamera::FrameKernels
+SeekThermalCamera::selectFrameKernels( SeekDevice::Type type ) noexcept
+{
+  try {
+    return visitDeviceTraits( type, "selectFrameKernels", []( auto traits ) {
+      using Traits = decltype( traits );
+      FrameKernels kernels;
+      kernels.width = Traits::kWidth;
+      kernels.height = Traits::kHeight;
+      kernels.frame_header_size = Traits::kFrameHeaderSize;
+      kernels.transfer_total_size = Traits::kTransferTotalSize;
+      kernels.transfer_request_size = Traits::kTransferRequestSize;
+      kernels.transfer_device_request_size = Traits::kTransferDeviceRequestSize;
+      kernels.min_header_size = Traits::kMinHeaderSize;
+      kernels.row_stride = Traits::kRowStride;
+      kernels.column_reference_offset =
+          Traits::kColumnReferenceRow < 0 ? -1 : Traits::kColumnReferenceRow * Traits::kRowStep;
+      kernels.extract = &extractKernel<Traits>;
+      kernels.pad_drift_signal = &padDriftSignalKernel<Traits>;
+      return kernels;
+    } );
+  } catch ( const InvalidDeviceError & ) {
+    return {};
+  }
+}
+
 void SeekThermalCamera::open()
 {
+  OPENSEEKTHERMAL_TRACE_SCOPE( "SeekThermalCamera::open" );
+  if ( kernels_.extract == nullptr )
+    throw InvalidDeviceError( "Unsupported device type " + to_string( device_.type ) );
   openDevice();
+  {
+    // The startup sequence below seeds c0 unless a host calibration owns it.
+    // Calibrations set while it runs are installed once it is done.
+    std::lock_guard buffer_lock( buffer_mutex_ );
+    setGrabbing( true );
+    installPendingCalibration();
+  }
+  sentinel_map_.reset( kernels_.width, kernels_.height, kernels_.row_stride );
+  sentinel_map_.setCalibratedDeadPixels( calibration_->dead_pixels ? &*calibration_->dead_pixels
+                                                                   : nullptr );
   try {
     // setupCamera() ends with SET_OPERATION_MODE=1, after which the camera
     // emits a deterministic boot sequence. tryConsumeStartupFrames() needs the
@@ -47,15 +210,23 @@ void SeekThermalCamera::open()
     // begins with SET_OPERATION_MODE=0) and retry.
     constexpr int kSetupAttempts = 5;
     for ( int attempt = 0; attempt < kSetupAttempts; ++attempt ) {
-      setupCamera();
-      if ( tryConsumeStartupFrames() )
+      {
+        OPENSEEKTHERMAL_TRACE_SCOPE( "SeekThermalCamera::setupCamera" );
+        setupCamera();
+      }
+      if ( tryConsumeStartupFrames() ) {
+        std::lock_guard buffer_lock( buffer_mutex_ );
+        setGrabbing( false );
+        installPendingCalibration();
         return;
+      }
       LOG_WARN( "Did not observe ft=8 + first ft=3 in startup frame budget on attempt "
                 << ( attempt + 1 ) << "/" << kSetupAttempts << "; restarting camera." );
     }
     throw SeekSetupError( "Camera did not emit ft=8 + first ft=3 startup frames after " +
                           std::to_string( kSetupAttempts ) + " attempts" );
   } catch ( const std::exception & ) {
+    setGrabbing( false );
     // Clean up device before throwing.
     close();
     throw;
@@ -162,6 +333,8 @@ void SeekThermalCamera::close()
   drift_reference_anchor_ = 0.0;
   last_shutter_mean_ = 0.0;
   shutter_offset_.clear();
+  column_reference_.clear();
+  selectPipelineStages();
 }
 
 bool SeekThermalCamera::write( SeekDeviceCommand command, const std::vector<unsigned char> &data )
@@ -222,15 +395,41 @@ int SeekThermalCamera::getFrameWidth() const { return device_.getFrameWidth(); }
 
 int SeekThermalCamera::getFrameHeight() const { return device_.getFrameHeight(); }
 
+int SeekThermalCamera::getOutputWidth() const
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  return outputWidth();
+}
+
+int SeekThermalCamera::getOutputHeight() const
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  return outputHeight();
+}
+
+size_t SeekThermalCamera::getOutputFrameSize() const
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  return outputPixelCount() * sizeof( uint16_t );
+}
+
 Framerate SeekThermalCamera::getMaxFramerate() const { return device_.getMaxFramerate(); }
 
+Framerate SeekThermalCamera::getOutputFramerate() const
+{
+  const Framerate rate = getMaxFramerate();
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  return { rate.numerator, rate.denominator * frame_decimation_ };
+}
+
 GrabFrameResult SeekThermalCamera::_grabRawFrame( unsigned char **frame_data, size_t &size )
 {
+  OPENSEEKTHERMAL_TRACE_SCOPE( "SeekThermalCamera::_grabRawFrame" );
   std::lock_guard device_lock( device_mutex_ );
   if ( usb_device_handle_ == nullptr ) {
     return GrabFrameResult::DEVICE_NOT_OPEN;
   }
-  int todo = device_._getFrameTransferTotalSize();
+  int todo = kernels_.transfer_total_size;
   if ( *frame_data == nullptr ) {
     size = todo;
     *frame_data = new unsigned char[size];
@@ -240,13 +439,14 @@ GrabFrameResult SeekThermalCamera::_grabRawFrame( unsigned char **frame_data, si
   }
   // Send transfer request
   {
-    const u_int32_t device_total_size = htole32( device_._getFrameTransferDeviceRequestSize() );
+    const u_int32_t device_total_size = htole32( kernels_.transfer_device_request_size );
     const auto *b = reinterpret_cast<const uint8_t *>( &device_total_size );
     if ( !write( SeekDeviceCommand::START_GET_IMAGE_TRANSFER, { b[0], b[1], b[2], b[3] } ) )
       return GrabFrameResult::FAILED_TO_START_TRANSFER;
+    OPENSEEKTHERMAL_TRACE_INSTANT( "usb_request_sent", kernels_.transfer_total_size );
   }
   GrabFrameResult result = GrabFrameResult::SUCCESS;
-  const int request_size = device_._getFrameTransferRequestSize();
+  const int request_size = kernels_.transfer_request_size;
   int done = 0;
   unsigned char *buffer = *frame_data;
   while ( todo > 0 ) {
@@ -258,12 +458,13 @@ GrabFrameResult SeekThermalCamera::_grabRawFrame( unsigned char **frame_data, si
       result = GrabFrameResult::TRANSFER_INCOMPLETE;
       break;
     }
+    OPENSEEKTHERMAL_TRACE_INSTANT( "usb_bulk_chunk", transferred );
     buffer += transferred;
     done += transferred;
     todo -= transferred;
     if ( todo != 0 && transferred == 0 ) {
       LOG_ERROR( "Frame transfer stopped prematurely! Received only "
-                 << done << " out of " << device_._getFrameTransferTotalSize() << " bytes." );
+                 << done << " out of " << kernels_.transfer_total_size << " bytes." );
       result = GrabFrameResult::TRANSFER_INCOMPLETE;
       break;
     }
@@ -281,152 +482,501 @@ bool SeekThermalCamera::triggerShutter()
 }
 
 GrabFrameResult SeekThermalCamera::grabRawCountsFrame( unsigned char **image_data, size_t &size,
-                                                       FrameHeader *header )
+                                                       FrameHeader *header, FrameStats *stats )
+{
+  OPENSEEKTHERMAL_TRACE_SCOPE( "SeekThermalCamera::grabRawCountsFrame" );
+  FrameOutputs outputs;
+  outputs.stats = stats;
+  return grabIntoBuffer( image_data, size, &FrameOutputs::counts, outputs, header );
+}
+
+GrabFrameResult SeekThermalCamera::grabFrame( unsigned char **image_data, size_t &size,
+                                              FrameHeader *header, FrameStats *stats )
+{
+  FrameOutputs outputs;
+  outputs.stats = stats;
+  return grabIntoBuffer( image_data, size, &FrameOutputs::centi_kelvin, outputs, header );
+}
+
+GrabFrameResult SeekThermalCamera::grabFrame( float **temperatures, size_t &size,
+                                              TemperatureUnit unit, FrameHeader *header )
+{
+  FrameOutputs outputs;
+  outputs.temperature_unit = unit;
+  return grabIntoBuffer( temperatures, size, &FrameOutputs::temperature, outputs, header );
+}
+
+GrabFrameResult SeekThermalCamera::grabFrame( const FrameOutputs &outputs, FrameHeader *header )
+{
+  return grabProcessedFrame( outputs, header );
+}
+
+template<typename T, typename Output>
+GrabFrameResult SeekThermalCamera::grabIntoBuffer( T **data, size_t &size,
+                                                   Output *FrameOutputs::*output,
+                                                   FrameOutputs outputs, FrameHeader *header )
 {
   std::lock_guard device_lock( device_mutex_ );
-  std::lock_guard buffer_lock( buffer_mutex_ );
   if ( usb_device_handle_ == nullptr ) {
     return GrabFrameResult::DEVICE_NOT_OPEN;
   }
-  if ( image_data != nullptr && *image_data != nullptr && size < getFrameSize() ) {
+  std::unique_lock buffer_lock( buffer_mutex_ );
+  if ( !prepareOutputBuffer( data, size, outputPixelCount() * sizeof( Output ) ) ) {
     return GrabFrameResult::BUFFER_TOO_SMALL;
   }
-  // Init buffer if not provided
-  if ( image_data != nullptr && *image_data == nullptr ) {
-    size = getFrameSize();
-    *image_data = new unsigned char[size];
+  if ( data != nullptr )
+    outputs.*output = reinterpret_cast<Output *>( *data );
+  return runGrab(
+      [&]() { return grabProcessedFrameLocked( buffer_lock, outputs, header ); } );
+}
+
+template<typename Grab>
+GrabFrameResult SeekThermalCamera::runGrab( Grab &&grab )
+{
+  setGrabbing( true );
+  installPendingCalibration();
+  GrabFrameResult result;
+  try {
+    result = grab();
+  } catch ( ... ) {
+    // A calibration set meanwhile is installed by the next grab.
+    setGrabbing( false );
+    throw;
   }
+  setGrabbing( false );
+  installPendingCalibration();
+  return result;
+}
 
-  if ( buffer_.size() < static_cast<size_t>( device_._getFrameTransferTotalSize() ) ) {
-    buffer_.resize( device_._getFrameTransferTotalSize() );
+GrabFrameResult SeekThermalCamera::grabProcessedFrame( const FrameOutputs &outputs,
+                                                       FrameHeader *header )
+{
+  std::lock_guard device_lock( device_mutex_ );
+  std::unique_lock buffer_lock( buffer_mutex_ );
+  return runGrab(
+      [&]() { return grabProcessedFrameLocked( buffer_lock, outputs, header ); } );
+}
+
+GrabFrameResult
+SeekThermalCamera::grabProcessedFrameLocked( std::unique_lock<std::mutex> &buffer_lock,
+                                             const FrameOutputs &outputs, FrameHeader *header )
+{
+  OPENSEEKTHERMAL_TRACE_SCOPE( "SeekThermalCamera::grabProcessedFrame" );
+  if ( usb_device_handle_ == nullptr ) {
+    return GrabFrameResult::DEVICE_NOT_OPEN;
   }
-  unsigned char *buffer = buffer_.data();
-  size_t buffer_size = buffer_.size();
-  if ( GrabFrameResult result = _grabRawFrame( &buffer, buffer_size );
-       result != GrabFrameResult::SUCCESS ) {
-    return result;
+
+  // The outputs are sized for the output size at the start of the grab.
+  const int output_width = outputWidth();
+  const int output_height = outputHeight();
+  FrameHeader internal_header;
+  size_t buffer_size = 0;
+  // Decimated thermal frames are dropped right after the transfer; shutter
+  // frames still refresh the flat-field reference in grabTransfer(). The
+  // setters are not blocked while a transfer is in flight.
+  for ( ;; ) {
+    if ( GrabFrameResult result = grabTransfer( internal_header, buffer_size, &buffer_lock );
+         result != GrabFrameResult::SUCCESS ) {
+      return result;
+    }
+    if ( internal_header.getFrameType() != FrameType::THERMAL_FRAME )
+      break;
+    if ( decimation_phase_ == 0 ) {
+      decimation_phase_ = frame_decimation_ - 1;
+      break;
+    }
+    --decimation_phase_;
   }
+  // Adopt a calibration set while the transfer was in flight.
+  installPendingCalibration();
 
-  static hector_timeit::Timer timer( "FrameProcessing", hector_timeit::Timer::Default, false, true );
-  hector_timeit::TimeBlock block( timer );
-  const int header_size = device_._getFrameHeaderSize();
-  const size_t pixel_count =
-      static_cast<size_t>( getFrameWidth() ) * static_cast<size_t>( getFrameHeight() );
-  FrameHeader internal_header(
-      device_.type,
-      std::vector<unsigned char>(
-          buffer_.begin(),
-          buffer_.begin() +
-              std::min<size_t>( buffer_size, FrameHeader::GetMinHeaderSize( device_.type ) ) ) );
+  ScopedLatency processing_latency( metrics_.processingLatency() );
   const FrameType frame_type = internal_header.getFrameType();
   if ( header != nullptr ) {
     *header = internal_header;
   }
 
+  if ( outputs.raw_counts == nullptr && outputs.counts == nullptr &&
+       outputs.centi_kelvin == nullptr && outputs.temperature == nullptr )
+    return GrabFrameResult::SUCCESS;
+  if ( outputWidth() != output_width || outputHeight() != output_height )
+    return GrabFrameResult::BUFFER_TOO_SMALL;
+  // With a processing window or binning everything below runs on region-sized
+  // buffers that are reduced to the output size band by band.
+  const FrameOutputs pass = reducesOutputs() ? regionOutputs( outputs ) : outputs;
+  const size_t pixel_count = processingPixelCount();
+  uint16_t *frame = pipelineFrame( pass );
+  uint16_t *source = pass.raw_counts != nullptr ? pass.raw_counts : frame;
+
+  // Only learn sentinel positions from the regular stream; the shutter
+  // sequence and other transfers can carry atypical content.
+  const bool thermal = frame_type == FrameType::THERMAL_FRAME;
+  const size_t sentinels =
+      extractProcessingRegion( buffer_.data() + kernels_.frame_header_size, source, thermal,
+                               thermal ? updateColumnOffsets( buffer_size ) : nullptr );
+  if ( frame_type != FrameType::THERMAL_FRAME ) {
+    for ( uint16_t *out : { pass.counts, pass.centi_kelvin } ) {
+      if ( out != nullptr && out != source )
+        std::copy( source, source + pixel_count, out );
+    }
+    if ( pass.temperature != nullptr ) {
+      for ( size_t i = 0; i < pixel_count; ++i ) pass.temperature[i] = source[i];
+    }
+    if ( reducesOutputs() ) {
+      reduceOutputRows( pass, source, outputs, 0, pipeline_.height() );
+    } else if ( outputs.stats != nullptr ) {
+      stats_accumulator_.reset();
+      stats_accumulator_.add( source, pixel_count );
+      stats_accumulator_.finish( *outputs.stats );
+    }
+    if ( outputs.stats != nullptr )
+      outputs.stats->sentinel_count = sentinels;
+    return GrabFrameResult::SUCCESS;
+  }
+
+  const int32_t drift_offset =
+      ( pipeline_stages_ & FramePipeline::kDrift ) ? computeDriftOffset( buffer_size ) : 0;
+  processThermalFrame( internal_header, pipeline_stages_, source, frame, drift_offset, pass,
+                       outputs );
+  if ( outputs.stats != nullptr )
+    outputs.stats->sentinel_count = sentinels;
+  return GrabFrameResult::SUCCESS;
+}
+
+GrabFrameResult SeekThermalCamera::grabIntegratedFrame( int frame_count,
+                                                        const FrameOutputs &outputs,
+                                                        FrameHeader *header )
+{
+  if ( frame_count < 1 || frame_count > kMaxIntegratedFrames ) {
+    throw std::invalid_argument( "Integration frame count must be in [1, " +
+                                 std::to_string( kMaxIntegratedFrames ) + "]" );
+  }
+  std::lock_guard device_lock( device_mutex_ );
+  std::unique_lock buffer_lock( buffer_mutex_ );
+  return runGrab( [&]() {
+    return grabIntegratedFrameLocked( buffer_lock, frame_count, outputs, header );
+  } );
+}
+
+GrabFrameResult
+SeekThermalCamera::grabIntegratedFrameLocked( std::unique_lock<std::mutex> &buffer_lock,
+                                              int frame_count, const FrameOutputs &outputs,
+                                              FrameHeader *header )
+{
+  if ( usb_device_handle_ == nullptr ) {
+    return GrabFrameResult::DEVICE_NOT_OPEN;
+  }
+  if ( outputs.raw_counts == nullptr && outputs.counts == nullptr &&
+       outputs.centi_kelvin == nullptr && outputs.temperature == nullptr )
+    return GrabFrameResult::SUCCESS;
+  const int output_width = outputWidth();
+  const int output_height = outputHeight();
+
+  // The sum is kept relative to the flat-field reference the final pass will
+  // apply. A shutter event mid-integration rebases the frames summed so far
+  // onto the new reference, so every frame ends up corrected by the reference
+  // that was current when it was captured.
+  auto currentReference = [this]() -> const int32_t * {
+    return ( pipeline_stages_ & FramePipeline::kFlatField ) ? shutterOffset() : nullptr;
+  };
+  size_t pixel_count = 0;
+  int64_t drift_sum = 0;
+  size_t sentinel_sum = 0;
+  int integrated = 0;
+  const auto restart = [&]() {
+    pixel_count = processingPixelCount();
+    integration_sum_.assign( pixel_count, 0 );
+    integration_reference_.clear();
+    if ( const int32_t *reference = currentReference() )
+      integration_reference_.assign( reference, reference + pixel_count );
+    frame_scratch_.resize( pixel_count );
+    drift_sum = 0;
+    sentinel_sum = 0;
+    integrated = 0;
+  };
+  restart();
+  FrameHeader internal_header;
+  while ( integrated < frame_count ) {
+    // The setters run while the transfer is in flight. One that changed the
+    // processing configuration invalidates the frames summed so far.
+    const uint64_t generation = configuration_generation_;
+    size_t buffer_size = 0;
+    if ( GrabFrameResult result = grabTransfer( internal_header, buffer_size, &buffer_lock );
+         result != GrabFrameResult::SUCCESS ) {
+      return result;
+    }
+    if ( configuration_generation_ != generation )
+      restart();
+    const FrameType frame_type = internal_header.getFrameType();
+    if ( frame_type == FrameType::CALIBRATION_FRAME ) {
+      const int32_t *reference = currentReference();
+      if ( integrated > 0 ) {
+        rebaseIntegrationSum( integration_sum_.data(),
+                              integration_reference_.empty() ? nullptr
+                                                             : integration_reference_.data(),
+                              reference, pixel_count, static_cast<uint32_t>( integrated ) );
+      }
+      if ( reference != nullptr )
+        integration_reference_.assign( reference, reference + pixel_count );
+      else
+        integration_reference_.clear();
+    }
+    if ( frame_type != FrameType::THERMAL_FRAME )
+      continue;
+    sentinel_sum += extractProcessingRegion( buffer_.data() + kernels_.frame_header_size,
+                                             frame_scratch_.data(), true,
+                                             updateColumnOffsets( buffer_size ) );
+    accumulateFrame( frame_scratch_.data(), integration_sum_.data(), pixel_count );
+    if ( pipeline_stages_ & FramePipeline::kDrift )
+      drift_sum += computeDriftOffset( buffer_size );
+    ++integrated;
+  }
+  if ( header != nullptr ) {
+    *header = internal_header;
+  }
+  if ( outputWidth() != output_width || outputHeight() != output_height )
+    return GrabFrameResult::BUFFER_TOO_SMALL;
+
+  const FrameOutputs pass = reducesOutputs() ? regionOutputs( outputs ) : outputs;
+  uint16_t *frame = pipelineFrame( pass );
+  uint16_t *source = pass.raw_counts != nullptr ? pass.raw_counts : frame;
+  averageFrames( integration_sum_.data(), source, pixel_count,
+                 static_cast<uint32_t>( frame_count ) );
+  const int32_t drift_offset =
+      static_cast<int32_t>( std::lround( static_cast<double>( drift_sum ) / frame_count ) );
+  // The average is already as quiet as the filter could make it and must not
+  // be blended into (or reset) the streaming history.
+  processThermalFrame( internal_header, pipeline_stages_ & ~FramePipeline::kTemporalFilter,
+                       source, frame, drift_offset, pass, outputs );
+  if ( outputs.stats != nullptr )
+    outputs.stats->sentinel_count = ( sentinel_sum + frame_count / 2 ) / frame_count;
+  return GrabFrameResult::SUCCESS;
+}
+
+GrabFrameResult SeekThermalCamera::grabTransfer( FrameHeader &header, size_t &buffer_size,
+                                                 std::unique_lock<std::mutex> *buffer_lock )
+{
+  if ( buffer_.size() < static_cast<size_t>( kernels_.transfer_total_size ) ) {
+    buffer_.resize( kernels_.transfer_total_size );
+  }
+  unsigned char *buffer = buffer_.data();
+  buffer_size = buffer_.size();
+  // `buffer_` is only used under device_mutex_, which stays locked.
+  if ( buffer_lock != nullptr )
+    buffer_lock->unlock();
+  const auto transfer_start = std::chrono::steady_clock::now();
+  GrabFrameResult result = _grabRawFrame( &buffer, buffer_size );
+  const auto transfer_end = std::chrono::steady_clock::now();
+  if ( buffer_lock != nullptr )
+    buffer_lock->lock();
+  if ( result != GrabFrameResult::SUCCESS ) {
+    if ( result == GrabFrameResult::FAILED_TO_START_TRANSFER ||
+         result == GrabFrameResult::TRANSFER_INCOMPLETE )
+      metrics_.recordTransferError();
+    return result;
+  }
+  metrics_.transferLatency().record( transfer_end - transfer_start );
+  header = FrameHeader(
+      device_.type,
+      std::vector<unsigned char>( buffer_.begin(),
+                                  buffer_.begin() +
+                                      std::min<size_t>( buffer_size, kernels_.min_header_size ) ) );
+  metrics_.recordFrame( header.getFrameNumber(),
+                        header.getFrameType() == FrameType::THERMAL_FRAME, transfer_end );
+
   // Periodic shutter cycle: update host-side FFC reference. Mean-preserving —
   // the shutter blade presents a roughly uniform thermal source, so per-pixel
   // variation in ft=1 is fixed-pattern offset stored as `mean - ft1[i]` and
   // added to each scene pixel; the frame mean (and thus the calibration
   // anchor) is preserved.
-  if ( frame_type == FrameType::CALIBRATION_FRAME ) {
+  if ( header.getFrameType() == FrameType::CALIBRATION_FRAME ) {
     LOG_DEBUG( "Shutter (ft=1) frame received, refreshing FFC reference" );
+    const size_t pixel_count =
+        static_cast<size_t>( kernels_.width ) * static_cast<size_t>( kernels_.height );
     std::vector<uint16_t> shutter( pixel_count );
-    extractFrame( buffer_.data() + header_size, reinterpret_cast<unsigned char *>( shutter.data() ) );
+    extractFrame( buffer_.data() + kernels_.frame_header_size,
+                  reinterpret_cast<unsigned char *>( shutter.data() ), false );
     applyShutterReference( shutter.data(), pixel_count );
     if ( c0_source_ == C0Source::CameraAuto )
       updateTemperatureCalibration( last_shutter_mean_,
                                     computePadDriftSignal( buffer_.data(), buffer_size ) );
+    // The new flat-field offsets include the current column pattern.
+    column_reference_.clear();
   }
+  return GrabFrameResult::SUCCESS;
+}
 
-  if ( image_data == nullptr )
-    return GrabFrameResult::SUCCESS;
+uint16_t *SeekThermalCamera::pipelineFrame( const FrameOutputs &outputs )
+{
+  // The pipeline finishes in the centi-Kelvin or counts output (or scratch if
+  // only float was requested) and reads from the raw output if requested, so
+  // no output is produced by copying another.
+  if ( outputs.centi_kelvin != nullptr )
+    return outputs.centi_kelvin;
+  if ( outputs.counts != nullptr )
+    return outputs.counts;
+  frame_scratch_.resize( processingPixelCount() );
+  return frame_scratch_.data();
+}
 
-  extractFrame( buffer_.data() + header_size, *image_data );
-  if ( frame_type != FrameType::THERMAL_FRAME )
-    return GrabFrameResult::SUCCESS;
+RegionOfInterest SeekThermalCamera::outputWindow() const noexcept
+{
+  return processing_window_ ? *processing_window_
+                            : RegionOfInterest{ 0, 0, kernels_.width, kernels_.height };
+}
 
-  // Thermal-only count pipeline: shutter → dead-pixel → vignette → drift.
-  auto *pixels = reinterpret_cast<uint16_t *>( *image_data );
-  if ( shutter_correction_enabled_ && shutter_offset_.size() == pixel_count ) {
-    for ( size_t i = 0; i < pixel_count; ++i ) {
-      const int32_t corrected = static_cast<int32_t>( pixels[i] ) + shutter_offset_[i];
-      pixels[i] = static_cast<uint16_t>( std::clamp( corrected, 0, 0xFFFF ) );
-    }
-  }
-  if ( calibration_.dead_pixels ) {
-    calibration_.dead_pixels->apply( pixels );
+FrameOutputs SeekThermalCamera::regionOutputs( const FrameOutputs &outputs )
+{
+  const size_t pixel_count = processingPixelCount();
+  const auto buffer = [pixel_count]( auto &storage, const void *requested ) {
+    if ( requested != nullptr )
+      storage.resize( pixel_count );
+    return requested != nullptr ? storage.data() : nullptr;
+  };
+  FrameOutputs region_outputs;
+  region_outputs.raw_counts = buffer( region_raw_counts_, outputs.raw_counts );
+  region_outputs.counts = buffer( region_counts_, outputs.counts );
+  region_outputs.centi_kelvin = buffer( region_centi_kelvin_, outputs.centi_kelvin );
+  region_outputs.temperature = buffer( region_temperature_, outputs.temperature );
+  region_outputs.temperature_unit = outputs.temperature_unit;
+  return region_outputs;
+}
+
+void SeekThermalCamera::reduceOutputRows( const FrameOutputs &region_outputs,
+                                          const uint16_t *stats_frame, const FrameOutputs &outputs,
+                                          int row_begin, int row_end )
+{
+  const RegionOfInterest &region = pipeline_.region();
+  const RegionOfInterest window = outputWindow();
+  const int factor = output_binning_;
+  const int width = window.width / factor;
+  const int height = window.height / factor;
+  if ( row_begin == 0 ) {
+    reduced_rows_ = 0;
+    if ( outputs.stats != nullptr )
+      stats_accumulator_.reset();
   }
-  if ( calibration_.vignette ) {
-    calibration_.vignette->apply( pixels );
+  // Output rows whose source rows are all complete.
+  const int top = window.y - region.y;
+  const int rows = row_end >= top ? std::min( height, ( row_end - top ) / factor ) : 0;
+  if ( rows <= reduced_rows_ )
+    return;
+  const size_t stride = region.width;
+  const size_t offset = static_cast<size_t>( top ) * stride + ( window.x - region.x );
+  if ( outputs.stats != nullptr )
+    reduced_row_.resize( width );
+  for ( ; reduced_rows_ < rows; ++reduced_rows_ ) {
+    const size_t input = offset + static_cast<size_t>( reduced_rows_ ) * factor * stride;
+    const size_t output = static_cast<size_t>( reduced_rows_ ) * width;
+    const auto reduce = [&]( const auto *region_output, auto *output_buffer ) {
+      if ( output_buffer != nullptr )
+        binRow( region_output + input, stride, factor, width, output_buffer + output );
+    };
+    reduce( region_outputs.raw_counts, outputs.raw_counts );
+    reduce( region_outputs.counts, outputs.counts );
+    reduce( region_outputs.centi_kelvin, outputs.centi_kelvin );
+    reduce( region_outputs.temperature, outputs.temperature );
+    if ( outputs.stats == nullptr )
+      continue;
+    // Statistics describe the returned frame, so reuse its reduced row if the
+    // caller requested that representation.
+    const uint16_t *row = reduced_row_.data();
+    if ( stats_frame == region_outputs.centi_kelvin && outputs.centi_kelvin != nullptr )
+      row = outputs.centi_kelvin + output;
+    else if ( stats_frame == region_outputs.counts && outputs.counts != nullptr )
+      row = outputs.counts + output;
+    else if ( stats_frame == region_outputs.raw_counts && outputs.raw_counts != nullptr )
+      row = outputs.raw_counts + output;
+    else
+      binRow( stats_frame + input, stride, factor, width, reduced_row_.data() );
+    stats_accumulator_.add( row, width );
   }
-  // In-band substrate-drift compensation; see setDriftCompensationEnabled()
-  // docstring for the full model.
-  int32_t drift_offset_int = 0;
-  const bool drift_active = substrate_drift_coefficient_ > 0.0 && drift_compensation_enabled_;
-  if ( drift_active && drift_anchor_set_ ) {
-    const double pad_drift_signal = computePadDriftSignal( buffer_.data(), buffer_size );
-    if ( pad_drift_signal > 0.0 ) {
-      const double pad_term =
-          substrate_drift_coefficient_ * ( pad_drift_signal - drift_reference_anchor_ );
-      drift_offset_int = static_cast<int32_t>( std::lround( pad_term ) );
+  if ( outputs.stats != nullptr && reduced_rows_ == height )
+    stats_accumulator_.finish( *outputs.stats );
+}
+
+void SeekThermalCamera::processThermalFrame( const FrameHeader &header, unsigned stages,
+                                             const uint16_t *source, uint16_t *frame,
+                                             int32_t drift_offset, const FrameOutputs &outputs,
+                                             const FrameOutputs &reduced_outputs )
+{
+  const size_t pixel_count = processingPixelCount();
+  const int width = pipeline_.width();
+  // Thermal-only pipeline: shutter → dead-pixel → vignette → non-uniformity
+  // → drift [→ temperature], interleaved with the user stages and fused into as few
+  // passes as the current configuration allows.
+  if ( outputs.centi_kelvin == nullptr )
+    stages &= ~FramePipeline::kTemperature;
+  if ( outputs.temperature == nullptr )
+    stages &= ~FramePipeline::kTemperatureFloat;
+  if ( outputs.centi_kelvin != nullptr && outputs.counts != nullptr )
+    stages |= FramePipeline::kCounts;
+  if ( drift_offset == 0 )
+    stages &= ~FramePipeline::kDrift;
+  FramePipeline::FrameInputs inputs;
+  inputs.shutter_offset = shutterOffset();
+  inputs.drift_offset = drift_offset;
+  if ( stages & FramePipeline::kTemporalFilter ) {
+    if ( temporal_history_.size() != pixel_count ) {
+      temporal_history_.assign( pixel_count, 0 );
+      temporal_reset_ = true;
     }
+    inputs.temporal_history = temporal_history_.data();
+    inputs.temporal_reset = temporal_reset_;
+    temporal_reset_ = false;
   }
-  if ( drift_offset_int != 0 ) {
-    for ( size_t i = 0; i < pixel_count; ++i ) {
-      const int32_t corrected = static_cast<int32_t>( pixels[i] ) - drift_offset_int;
-      pixels[i] = static_cast<uint16_t>( std::clamp( corrected, 0, 0xFFFF ) );
-    }
+  FramePipeline::FrameOutputs pass_outputs;
+  pass_outputs.frame = frame;
+  pass_outputs.counts = outputs.counts;
+  pass_outputs.temperature = outputs.temperature;
+  pass_outputs.temperature_unit = outputs.temperature_unit;
+  pipeline_.prepare( stages, inputs, pass_outputs );
+  stages = pipeline_.activeStages();
+  // No temperature mapping installed: `frame` holds the corrected counts, which
+  // are copied to the other outputs band by band, ahead of the reduction.
+  const bool mapped = ( stages & FramePipeline::kTemperature ) != 0;
+  uint16_t *copy_counts = !mapped && outputs.counts != frame ? outputs.counts : nullptr;
+  float *copy_temperature =
+      !mapped && ( stages & FramePipeline::kTemperatureFloat ) == 0 ? outputs.temperature : nullptr;
+  const bool reduce = reducesOutputs();
+  ProcessingPipeline::BandCallback on_band;
+  if ( copy_counts != nullptr || copy_temperature != nullptr || reduce ) {
+    on_band = [&]( int row_begin, int row_end ) {
+      const size_t begin = static_cast<size_t>( row_begin ) * width;
+      const size_t end = static_cast<size_t>( row_end ) * width;
+      if ( copy_counts != nullptr )
+        std::copy( frame + begin, frame + end, copy_counts + begin );
+      if ( copy_temperature != nullptr ) {
+        for ( size_t i = begin; i < end; ++i ) copy_temperature[i] = frame[i];
+      }
+      if ( reduce )
+        reduceOutputRows( outputs, frame, reduced_outputs, row_begin, row_end );
+    };
   }
-  return GrabFrameResult::SUCCESS;
+  if ( outputs.stats != nullptr )
+    stats_accumulator_.reset();
+  processing_.run( header, source, frame, outputs.stats != nullptr ? &stats_accumulator_ : nullptr,
+                   on_band );
+  if ( outputs.stats != nullptr )
+    stats_accumulator_.finish( *outputs.stats );
 }
 
-GrabFrameResult SeekThermalCamera::grabFrame( unsigned char **image_data, size_t &size,
-                                              FrameHeader *header )
+int32_t SeekThermalCamera::computeDriftOffset( size_t transfer_buffer_size ) const
 {
-  FrameHeader internal_header;
-  if ( GrabFrameResult result = grabRawCountsFrame( image_data, size, &internal_header );
-       result != GrabFrameResult::SUCCESS )
-    return result;
-  if ( header != nullptr )
-    *header = internal_header;
-  if ( image_data == nullptr || internal_header.getFrameType() != FrameType::THERMAL_FRAME )
-    return GrabFrameResult::SUCCESS;
-
-  // Map drift-compensated counts to centi-Kelvin.
-  std::lock_guard buffer_lock( buffer_mutex_ );
-  const size_t pixel_count =
-      static_cast<size_t>( getFrameWidth() ) * static_cast<size_t>( getFrameHeight() );
-  auto *pixels = reinterpret_cast<uint16_t *>( *image_data );
-  const TemperatureCalibration &cal_to_apply = *calibration_.temperature;
-  for ( size_t i = 0; i < pixel_count; ++i ) { pixels[i] = cal_to_apply.apply( pixels[i] ); }
-  return GrabFrameResult::SUCCESS;
+  // In-band substrate-drift compensation; see setDriftCompensationEnabled()
+  // docstring for the full model.
+  const double pad_drift_signal = computePadDriftSignal( buffer_.data(), transfer_buffer_size );
+  if ( pad_drift_signal <= 0.0 )
+    return 0;
+  const double pad_term =
+      substrate_drift_coefficient_ * ( pad_drift_signal - drift_reference_anchor_ );
+  return static_cast<int32_t>( std::lround( pad_term ) );
 }
 
 double SeekThermalCamera::computePadDriftSignal( const unsigned char *transfer_buffer,
                                                  size_t transfer_buffer_size ) const
 {
-  const int header_size = device_._getFrameHeaderSize();
-  const int row_u16 = device_._getRowStep() / 2;
-  const int visible_rows = getFrameHeight();
-  const int pad_col = getFrameWidth();
-  if ( transfer_buffer_size <
-       static_cast<size_t>( header_size ) +
-           static_cast<size_t>( visible_rows ) * static_cast<size_t>( row_u16 ) * 2 ) {
-    return 0.0;
-  }
-  const auto *body_u16 = reinterpret_cast<const uint16_t *>( transfer_buffer + header_size );
-  uint64_t sum = 0;
-  int count = 0;
-  for ( int y = 0; y < visible_rows; ++y ) {
-    // Skip sentinels (0 / 0xFFFF). They appear in some startup/test transfers
-    // and would skew the mean.
-    const uint16_t v = le16toh( body_u16[y * row_u16 + pad_col] );
-    if ( v == 0 || v == 0xFFFF )
-      continue;
-    sum += v;
-    ++count;
-  }
-  return count > 0 ? static_cast<double>( sum ) / count : 0.0;
+  return kernels_.pad_drift_signal( transfer_buffer, transfer_buffer_size );
 }
 
 void SeekThermalCamera::applyShutterReference( const uint16_t *shutter, size_t pixel_count )
@@ -456,6 +1006,7 @@ void SeekThermalCamera::applyShutterReference( const uint16_t *shutter, size_t p
     const int32_t v = shutter[i];
     shutter_offset_[i] = ( v == 0 || v == 0xFFFF ) ? 0 : mean - v;
   }
+  selectPipelineStages();
 }
 
 bool SeekThermalCamera::tryConsumeStartupFrames()
@@ -466,9 +1017,9 @@ bool SeekThermalCamera::tryConsumeStartupFrames()
   // a stray transfer error doesn't immediately force a setupCamera() retry.
   constexpr int kBudget = 24;
   const size_t pixel_count =
-      static_cast<size_t>( getFrameWidth() ) * static_cast<size_t>( getFrameHeight() );
-  const int header_size = device_._getFrameHeaderSize();
-  std::vector<unsigned char> transfer( device_._getFrameTransferTotalSize() );
+      static_cast<size_t>( kernels_.width ) * static_cast<size_t>( kernels_.height );
+  const int header_size = kernels_.frame_header_size;
+  std::vector<unsigned char> transfer( kernels_.transfer_total_size );
   std::vector<uint16_t> extracted( pixel_count );
   bool ft8_seen = false;
   double boot_shutter_pad = 0.0;
@@ -481,25 +1032,25 @@ bool SeekThermalCamera::tryConsumeStartupFrames()
         device_.type,
         std::vector<unsigned char>(
             transfer.begin(),
-            transfer.begin() +
-                std::min<size_t>( buf_size, FrameHeader::GetMinHeaderSize( device_.type ) ) ) );
+            transfer.begin() + std::min<size_t>( buf_size, kernels_.min_header_size ) ) );
     const FrameType ft = header.getFrameType();
     // Seed the per-unit firmware SLOPE c1 = 100 / counts (row 1 byte 16, present
     // in every transfer) unless one is already installed. The absolute offset c0
     // is filled in once the boot shutter (ft=8) and drift anchor (first ft=3) are
     // both known (below); until then it stays 0.
-    if ( !calibration_.temperature ) {
+    if ( !calibration_->temperature ) {
       const uint16_t counts = header.getCountsPer100Celsius();
       if ( counts != 0 ) {
         TemperatureCalibration t;
         t.c1 = 100.0 / static_cast<double>( counts );
         t.c0 = 0.0;
-        calibration_.temperature = t;
+        publishTemperature( t );
       }
     }
     if ( !ft8_seen && ft == FrameType::STARTUP_CALIBRATION_FRAME ) {
+      // Boot transfers are not representative of the stream; don't learn from them.
       extractFrame( transfer.data() + header_size,
-                    reinterpret_cast<unsigned char *>( extracted.data() ) );
+                    reinterpret_cast<unsigned char *>( extracted.data() ), false );
       applyShutterReference( extracted.data(), pixel_count );
       ft8_seen = shutter_offset_.size() == pixel_count;
       if ( ft8_seen ) {
@@ -526,77 +1077,250 @@ bool SeekThermalCamera::tryConsumeStartupFrames()
         // unreliable when the camera boots warm -- is not needed. Re-anchored at
         // every later shutter in grabRawCountsFrame.
         // Skipped when a host temperature calibration is provided.
-        if ( factory_T_ref_ > 0.0 && calibration_.temperature && c0_source_ != C0Source::Host &&
+        if ( factory_T_ref_ > 0.0 && calibration_->temperature && c0_source_ != C0Source::Host &&
              substrate_drift_coefficient_ > 0.0 && boot_shutter_pad > 0.0 ) {
           c0_source_ = C0Source::CameraAuto;
           updateTemperatureCalibration( last_shutter_mean_, boot_shutter_pad );
-          LOG_DEBUG( "[c0] camera-only offset c0=" << calibration_.temperature->c0
+          LOG_DEBUG( "[c0] camera-only offset c0=" << calibration_->temperature->c0
                                                    << " (T_ref=" << factory_T_ref_ << ")" );
         }
       }
     }
     if ( ft8_seen && drift_anchor_set_ ) {
-      if ( !calibration_.temperature ) {
+      if ( !calibration_->temperature ) {
         // If no slope could be found, install identity (cK == raw counts).
-        calibration_.temperature = TemperatureCalibration{ -273.15, 0.01 };
+        publishTemperature( TemperatureCalibration{ -273.15, 0.01 } );
       }
+      pipeline_.setTemperature( &*calibration_->temperature );
+      selectPipelineStages();
       return true;
     }
   }
   return false;
 }
 
-void SeekThermalCamera::extractFrame( const unsigned char *__restrict__ data,
-                                      unsigned char *__restrict__ frame_data )
-{
-  const int width = device_.getFrameWidth();
-  const int height = device_.getFrameHeight();
-  const int row_step = device_._getRowStep() / 2;
-  auto *data_in = reinterpret_cast<const uint16_t *>( data );
-  auto *data_out = reinterpret_cast<uint16_t *>( frame_data );
-  // Pass good pixels through unchanged; fall back to a 3x3 gaussian over the
-  // valid neighbours only when the center pixel itself is dead/saturated.
-  // Reads convert from on-wire LE to host once here; all downstream
-  // processing operates on host-endian pixels.
-  const int filter_weights[9] = { 1, 2, 1, 2, 4, 2, 1, 2, 1 };
-  for ( int y = 0; y < height; ++y ) {
-    for ( int x = 0; x < width; ++x ) {
-      const int out_index = y * width + x;
-      const uint16_t center_value = le16toh( data_in[y * row_step + x] );
-      if ( center_value != 0 && center_value != 0xffff ) {
-        data_out[out_index] = center_value;
-        continue;
-      }
-      int sum = 0;
-      int count = 0;
-      for ( int k = -1; k <= 1; ++k ) {
-        for ( int m = -1; m <= 1; ++m ) {
-          if ( ( k == 0 && m == 0 ) || y + k < 0 || y + k >= height || x + m < 0 || x + m >= width ) {
-            continue;
-          }
-          const int index = ( y + k ) * row_step + x + m;
-          const int value = le16toh( data_in[index] );
-          if ( value == 0 || value == 0xffff )
-            continue;
-          sum += value * filter_weights[( k + 1 ) * 3 + m + 1];
-          count += filter_weights[( k + 1 ) * 3 + m + 1];
-        }
-      }
-      data_out[out_index] = count == 0 ? 0 : static_cast<uint16_t>( sum / count );
+size_t SeekThermalCamera::extractFrame( const unsigned char *data, unsigned char *frame_data,
+                                        bool learn, const int32_t *column_offset )
+{
+  // Good pixels pass through unchanged; pixels reading 0 / 0xFFFF fall back to
+  // a 3x3 gaussian over their valid neighbours. Reads convert from on-wire LE
+  // to host once here; all downstream processing operates on host-endian pixels.
+  return kernels_.extract( sentinel_map_, data, frame_data, learn, column_offset );
+}
+
+size_t SeekThermalCamera::extractProcessingRegion( const unsigned char *data, uint16_t *frame,
+                                                   bool learn, const int32_t *column_offset )
+{
+  if ( !processing_window_ )
+    return extractFrame( data, reinterpret_cast<unsigned char *>( frame ), learn, column_offset );
+  const RegionOfInterest &region = pipeline_.region();
+  return sentinel_map_.extractRegion( reinterpret_cast<const uint16_t *>( data ), frame, region.x,
+                                      region.y, region.width, region.height, column_offset );
+}
+
+const int32_t *SeekThermalCamera::updateColumnOffsets( size_t transfer_buffer_size )
+{
+  // Smoothing of the per-column change: the reference row is a single noisy
+  // sample per column and frame, the pattern it tracks drifts slowly.
+  constexpr int kSmoothingShift = 3;
+  constexpr int kFractionBits = 8;
+  const int width = kernels_.width;
+  const int offset = kernels_.column_reference_offset;
+  if ( !column_correction_enabled_ || offset < 0 ||
+       transfer_buffer_size < static_cast<size_t>( offset ) + width * sizeof( uint16_t ) )
+    return nullptr;
+  // Read in place from the transfer header; the row is not copied per frame.
+  const auto *row = reinterpret_cast<const uint16_t *>( buffer_.data() + offset );
+  if ( column_reference_.size() != static_cast<size_t>( width ) ) {
+    column_reference_.resize( width );
+    for ( int x = 0; x < width; ++x ) column_reference_[x] = le16toh( row[x] );
+    column_drift_.assign( width, 0 );
+    column_offset_.assign( width, 0 );
+    return nullptr;
+  }
+  int64_t sum = 0;
+  for ( int x = 0; x < width; ++x ) {
+    const int32_t v = le16toh( row[x] );
+    const int32_t reference = column_reference_[x];
+    // Sentinel readings keep the previous estimate.
+    if ( v != 0 && v != 0xFFFF && reference != 0 && reference != 0xFFFF ) {
+      const int32_t target = ( v - reference ) * ( 1 << kFractionBits );
+      column_drift_[x] += ( target - column_drift_[x] ) / ( 1 << kSmoothingShift );
     }
+    sum += column_drift_[x];
+  }
+  const auto mean = static_cast<int32_t>( sum / width );
+  constexpr int32_t kHalf = 1 << ( kFractionBits - 1 );
+  for ( int x = 0; x < width; ++x ) {
+    column_offset_[x] = ( column_drift_[x] - mean + kHalf ) >> kFractionBits;
   }
+  return column_offset_.data();
 }
 
 void SeekThermalCamera::setShutterCorrectionEnabled( bool enabled )
 {
   std::lock_guard buffer_lock( buffer_mutex_ );
   shutter_correction_enabled_ = enabled;
+  configurationChanged();
 }
 
 void SeekThermalCamera::setDriftCompensationEnabled( bool enabled )
 {
   std::lock_guard buffer_lock( buffer_mutex_ );
   drift_compensation_enabled_ = enabled;
+  configurationChanged();
+}
+
+void SeekThermalCamera::setColumnCorrectionEnabled( bool enabled )
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  column_correction_enabled_ = enabled;
+  column_reference_.clear();
+  configurationChanged();
+}
+
+void SeekThermalCamera::selectPipelineStages()
+{
+  const size_t pixel_count =
+      static_cast<size_t>( kernels_.width ) * static_cast<size_t>( kernels_.height );
+  updateProcessingRegion();
+  unsigned stages = FramePipeline::kDeadPixels | FramePipeline::kVignette |
+                    FramePipeline::kNonUniformity | FramePipeline::kDistortion |
+                    FramePipeline::kTemperature | FramePipeline::kTemperatureFloat;
+  if ( shutter_correction_enabled_ && shutter_offset_.size() == pixel_count )
+    stages |= FramePipeline::kFlatField;
+  if ( substrate_drift_coefficient_ > 0.0 && drift_compensation_enabled_ && drift_anchor_set_ )
+    stages |= FramePipeline::kDrift;
+  if ( temporal_filter_ )
+    stages |= FramePipeline::kTemporalFilter;
+  if ( spatial_filter_ )
+    stages |= FramePipeline::kSpatialFilter;
+  pipeline_stages_ = stages & pipeline_.availableStages();
+  // Any change of the corrections, including a new shutter reference, shifts
+  // the pixel levels; restart the temporal filter instead of blending across.
+  temporal_reset_ = true;
+}
+
+void SeekThermalCamera::configurationChanged()
+{
+  ++configuration_generation_;
+  selectPipelineStages();
+}
+
+int SeekThermalCamera::processingWindowHalo() const noexcept
+{
+  return 1 + ( spatial_filter_ ? spatial_filter_->radius : 0 ) + pipeline_.distortionRadius();
+}
+
+void SeekThermalCamera::updateProcessingRegion()
+{
+  if ( !processing_window_ ) {
+    pipeline_.setRegion( {} );
+    window_shutter_offset_.clear();
+    return;
+  }
+  const RegionOfInterest &window = *processing_window_;
+  const int halo = processingWindowHalo();
+  pipeline_.setRegion( { window.x - halo, window.y - halo, window.width + 2 * halo,
+                         window.height + 2 * halo } );
+  const RegionOfInterest &region = pipeline_.region();
+  window_shutter_offset_.clear();
+  if ( shutter_offset_.size() != static_cast<size_t>( kernels_.width ) * kernels_.height )
+    return;
+  window_shutter_offset_.resize( processingPixelCount() );
+  for ( int y = 0; y < region.height; ++y ) {
+    const int32_t *row =
+        shutter_offset_.data() + static_cast<size_t>( region.y + y ) * kernels_.width + region.x;
+    std::copy( row, row + region.width,
+               window_shutter_offset_.data() + static_cast<size_t>( y ) * region.width );
+  }
+}
+
+void SeekThermalCamera::setProcessingWindow( const std::optional<RegionOfInterest> &window )
+{
+  std::optional<RegionOfInterest> clipped;
+  if ( window ) {
+    const int x0 = std::max( window->x, 0 );
+    const int y0 = std::max( window->y, 0 );
+    const int x1 = std::min( window->x + window->width, kernels_.width );
+    const int y1 = std::min( window->y + window->height, kernels_.height );
+    if ( x1 <= x0 || y1 <= y0 )
+      throw std::invalid_argument( "Processing window does not overlap the frame" );
+    clipped = RegionOfInterest{ x0, y0, x1 - x0, y1 - y0 };
+  }
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  if ( clipped && ( clipped->width < output_binning_ || clipped->height < output_binning_ ) )
+    throw std::invalid_argument( "Processing window is smaller than the output binning" );
+  processing_window_ = clipped;
+  configurationChanged();
+}
+
+void SeekThermalCamera::setOutputBinning( int factor )
+{
+  if ( factor != 1 && factor != 2 && factor != 4 )
+    throw std::invalid_argument( "Output binning must be 1, 2 or 4" );
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  const RegionOfInterest window = outputWindow();
+  if ( window.width < factor || window.height < factor )
+    throw std::invalid_argument( "Processing window is smaller than the output binning" );
+  output_binning_ = factor;
+}
+
+void SeekThermalCamera::setFrameDecimation( int factor )
+{
+  if ( factor < 1 )
+    throw std::invalid_argument( "Frame decimation must be at least 1" );
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  frame_decimation_ = factor;
+  decimation_phase_ = 0;
+}
+
+void SeekThermalCamera::setTemporalFilter( const std::optional<TemporalFilterSettings> &settings )
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  temporal_filter_ = settings;
+  pipeline_.setTemporalFilter( temporal_filter_ ? &*temporal_filter_ : nullptr );
+  configurationChanged();
+}
+
+void SeekThermalCamera::setSpatialFilter( const std::optional<SpatialFilterSettings> &settings )
+{
+  if ( settings && ( settings->radius < 1 || settings->radius > BilateralFilter::kMaxRadius ) ) {
+    throw std::invalid_argument( "Spatial filter radius must be 1 or 2" );
+  }
+  if ( settings &&
+       ( !std::isfinite( settings->sigma_spatial ) || !std::isfinite( settings->sigma_range ) ) ) {
+    throw std::invalid_argument( "Spatial filter sigmas must be finite" );
+  }
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  spatial_filter_ = settings;
+  pipeline_.setSpatialFilter( spatial_filter_ ? &*spatial_filter_ : nullptr );
+  configurationChanged();
+}
+
+void SeekThermalCamera::addProcessingStage( ProcessingStage::SharedPtr stage,
+                                            const std::string &before )
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  processing_.insertStage( std::move( stage ), before );
+}
+
+bool SeekThermalCamera::removeProcessingStage( const ProcessingStage::SharedPtr &stage )
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  return processing_.removeStage( stage.get() );
+}
+
+std::vector<ProcessingStage::SharedPtr> SeekThermalCamera::processingStages() const
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  return processing_.stages();
+}
+
+void SeekThermalCamera::setProcessingBandRows( int rows )
+{
+  std::lock_guard buffer_lock( buffer_mutex_ );
+  processing_.setBandRows( rows );
 }
 
 void SeekThermalCamera::setCalibration( CameraCalibration cal )
@@ -609,11 +1333,79 @@ void SeekThermalCamera::setCalibration( CameraCalibration cal )
                             cal.dead_pixels->height() != getFrameHeight() ) ) {
     throw std::invalid_argument( "Dead-pixel mask dimensions do not match camera frame" );
   }
+  if ( cal.distortion && ( cal.distortion->width != getFrameWidth() ||
+                           cal.distortion->height != getFrameHeight() ) ) {
+    throw std::invalid_argument( "Distortion model dimensions do not match camera frame" );
+  }
+  if ( cal.non_uniformity && ( cal.non_uniformity->width() != getFrameWidth() ||
+                               cal.non_uniformity->height() != getFrameHeight() ) ) {
+    throw std::invalid_argument(
+        "Non-uniformity correction dimensions do not match camera frame" );
+  }
+  // Compile outside of buffer_mutex_ and hand the result to the grabbing
+  // thread if a grab is in progress. A calibration set while an earlier one is
+  // still pending replaces it.
+  auto pending = std::make_shared<PendingCalibration>();
+  pending->compiled = FramePipeline::compile( cal, getFrameWidth(), getFrameHeight() );
+  pending->calibration = std::move( cal );
+  {
+    std::lock_guard calibration_lock( calibration_mutex_ );
+    pending_calibration_ = std::move( pending );
+    if ( grabbing_ )
+      return;
+  }
   std::lock_guard buffer_lock( buffer_mutex_ );
+  {
+    // A grab that started meanwhile picks it up itself. grabbing_ is only set
+    // under buffer_mutex_, so it can't start after this check.
+    std::lock_guard calibration_lock( calibration_mutex_ );
+    if ( grabbing_ )
+      return;
+  }
+  installPendingCalibration();
+}
+
+std::shared_ptr<const CameraCalibration> SeekThermalCamera::calibration() const
+{
+  std::lock_guard calibration_lock( calibration_mutex_ );
+  return calibration_;
+}
+
+void SeekThermalCamera::setGrabbing( bool grabbing )
+{
+  std::lock_guard calibration_lock( calibration_mutex_ );
+  grabbing_ = grabbing;
+}
+
+void SeekThermalCamera::publishCalibration( std::shared_ptr<const CameraCalibration> calibration )
+{
+  std::lock_guard calibration_lock( calibration_mutex_ );
+  calibration_ = std::move( calibration );
+}
+
+void SeekThermalCamera::publishTemperature( const TemperatureCalibration &temperature )
+{
+  auto calibration = std::make_shared<CameraCalibration>( *calibration_ );
+  calibration->temperature = temperature;
+  publishCalibration( std::move( calibration ) );
+}
+
+void SeekThermalCamera::installPendingCalibration()
+{
+  std::shared_ptr<PendingCalibration> pending;
+  {
+    std::lock_guard calibration_lock( calibration_mutex_ );
+    pending.swap( pending_calibration_ );
+  }
+  if ( pending == nullptr )
+    return;
+  CameraCalibration &cal = pending->calibration;
   // Keep the active temperature mapping (factory default from open(), or a
   // previously installed one) when the incoming calibration omits it. A host
   // temperature section takes ownership of c0 and stops the per-shutter
   // camera-only re-anchoring.
+  std::shared_ptr<const FramePipeline::TemperatureTable> temperature =
+      pending->compiled->temperature;
   if ( cal.temperature ) {
     // Host owns c0/c1 so a later open()/reopen() does not seed the camera-only
     // c0 over it (the calibration may be installed before open()).
@@ -627,9 +1419,14 @@ void SeekThermalCamera::setCalibration( CameraCalibration cal )
       drift_anchor_set_ = true;
     }
   } else {
-    cal.temperature = calibration_.temperature;
+    cal.temperature = calibration_->temperature;
+    temperature = pipeline_.calibration()->temperature;
   }
-  calibration_ = std::move( cal );
+  sentinel_map_.setCalibratedDeadPixels( cal.dead_pixels ? &*cal.dead_pixels : nullptr );
+  publishCalibration( std::make_shared<const CameraCalibration>( std::move( cal ) ) );
+  pipeline_.setCalibration( std::move( pending->compiled ) );
+  pipeline_.setTemperature( std::move( temperature ) );
+  configurationChanged();
 }
 
 void SeekThermalCamera::updateTemperatureCalibration( double shutter_mean, double shutter_pad )
@@ -638,12 +1435,15 @@ void SeekThermalCamera::updateTemperatureCalibration( double shutter_mean, doubl
   // reference). The shutter blade is a blackbody at the factory reference
   // temperature once the boot substrate state is removed. See
   // tryConsumeStartupFrames for the rationale.
-  if ( factory_T_ref_ <= 0.0 || !calibration_.temperature || substrate_drift_coefficient_ <= 0.0 ||
-       !drift_anchor_set_ || shutter_pad <= 0.0 )
+  if ( factory_T_ref_ <= 0.0 || !calibration_->temperature ||
+       substrate_drift_coefficient_ <= 0.0 || !drift_anchor_set_ || shutter_pad <= 0.0 )
     return;
   const double dc_shutter =
       shutter_mean - substrate_drift_coefficient_ * ( shutter_pad - drift_reference_anchor_ );
-  calibration_.temperature->c0 = factory_T_ref_ - calibration_.temperature->c1 * dc_shutter;
+  TemperatureCalibration temperature = *calibration_->temperature;
+  temperature.c0 = factory_T_ref_ - temperature.c1 * dc_shutter;
+  publishTemperature( temperature );
+  pipeline_.setTemperature( &*calibration_->temperature );
 }
 
 std::string SeekThermalCamera::readChipID()
@@ -3,8 +3,10 @@
 
 #include "openseekthermal/dead_pixel_mask.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace openseekthermal
@@ -26,6 +28,7 @@ DeadPixelMask::DeadPixelMask( int width, int height, const std::vector<bool> &ma
   if ( mask.size() != pixel_count ) {
     throw std::invalid_argument( "DeadPixelMask: mask size does not match width*height" );
   }
+  auto entries = std::make_shared<std::vector<DeadPixelEntry>>();
   for ( int y = 0; y < height; ++y ) {
     for ( int x = 0; x < width; ++x ) {
       const size_t idx = static_cast<size_t>( y ) * width + x;
@@ -51,9 +54,11 @@ DeadPixelMask::DeadPixelMask( int width, int height, const std::vector<bool> &ma
           ++entry.neighbor_count;
         }
       }
-      entries_.push_back( entry );
+      entries->push_back( entry );
     }
   }
+  count_ = entries->size();
+  entries_ = std::shared_ptr<const DeadPixelEntry>( entries, entries->data() );
 }
 
 DeadPixelMask::DeadPixelMask( int width, int height,
@@ -72,15 +77,36 @@ DeadPixelMask::DeadPixelMask( int width, int height,
   *this = DeadPixelMask( width, height, mask );
 }
 
-void DeadPixelMask::apply( uint16_t *frame ) const
+DeadPixelMask::DeadPixelMask( int width, int height, std::shared_ptr<const DeadPixelEntry> entries,
+                              size_t count )
+    : width_( width ), height_( height ), entries_( std::move( entries ) ), count_( count )
 {
-  for ( const DeadPixelEntry &entry : entries_ ) {
+}
+
+void DeadPixelMask::apply( uint16_t *frame ) const { applyRows( frame, frame, 0, height_ ); }
+
+void DeadPixelMask::applyRows( const uint16_t *input, uint16_t *frame, int row_begin,
+                               int row_end ) const
+{
+  const size_t begin = static_cast<size_t>( row_begin ) * width_;
+  const size_t end = static_cast<size_t>( row_end ) * width_;
+  if ( input != frame )
+    std::copy( input + begin, input + end, frame + begin );
+  // Entries are sorted by index (row-major construction).
+  const auto by_index = []( const DeadPixelEntry &entry, size_t index ) {
+    return entry.index < index;
+  };
+  const DeadPixelEntry *first = entries_.get();
+  const DeadPixelEntry *it = std::lower_bound( first, first + count_, begin, by_index );
+  const DeadPixelEntry *last = std::lower_bound( it, first + count_, end, by_index );
+  for ( ; it != last; ++it ) {
+    const DeadPixelEntry &entry = *it;
     if ( entry.neighbor_count == 0 )
       continue;
     int sum = 0;
     int total_weight = 0;
     for ( uint8_t i = 0; i < entry.neighbor_count; ++i ) {
-      const int v = frame[entry.neighbors[i]];
+      const int v = input[entry.neighbors[i]];
       const int w = entry.weights[i];
       sum += v * w;
       total_weight += w;
@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/distortion_correction.hpp"
+
+namespace openseekthermal
+{
+
+void DistortionCorrection::distort( double x, double y, double &sx, double &sy ) const
+{
+  const double xn = ( x - cx ) / fx;
+  const double yn = ( y - cy ) / fy;
+  const double r2 = xn * xn + yn * yn;
+  const double radial = 1.0 + r2 * ( k1 + r2 * ( k2 + r2 * k3 ) );
+  const double xd = xn * radial + 2.0 * p1 * xn * yn + p2 * ( r2 + 2.0 * xn * xn );
+  const double yd = yn * radial + p1 * ( r2 + 2.0 * yn * yn ) + 2.0 * p2 * xn * yn;
+  sx = xd * fx + cx;
+  sy = yd * fy + cy;
+}
+
+void DistortionCorrection::undistort( double sx, double sy, double &x, double &y ) const
+{
+  const double xd = ( sx - cx ) / fx;
+  const double yd = ( sy - cy ) / fy;
+  double xn = xd;
+  double yn = yd;
+  for ( int i = 0; i < 20; ++i ) {
+    const double r2 = xn * xn + yn * yn;
+    const double radial = 1.0 + r2 * ( k1 + r2 * ( k2 + r2 * k3 ) );
+    if ( radial <= 0.0 )
+      break;
+    const double dx = 2.0 * p1 * xn * yn + p2 * ( r2 + 2.0 * xn * xn );
+    const double dy = p1 * ( r2 + 2.0 * yn * yn ) + 2.0 * p2 * xn * yn;
+    xn = ( xd - dx ) / radial;
+    yn = ( yd - dy ) / radial;
+  }
+  x = xn * fx + cx;
+  y = yn * fy + cy;
+}
+
+} // namespace openseekthermal
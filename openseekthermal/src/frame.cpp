@@ -3,52 +3,30 @@
 
 #include "openseekthermal/detail/frame.hpp"
 #include "openseekthermal/detail/exceptions.hpp"
+#include "openseekthermal/detail/usb/device_traits.hpp"
 
 namespace openseekthermal
 {
 
 int FrameHeader::GetFrameNumberOffset( SeekDevice::Type type )
 {
-  switch ( type ) {
-  case SeekDevice::Type::SeekThermalCompact:
-    return 80;
-  case SeekDevice::Type::SeekThermalCompactPro:
-  case SeekDevice::Type::SeekThermalNano300:
-    return 2;
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "GetFrameNumberOffset not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "GetFrameNumberOffset", []( auto traits ) {
+    return decltype( traits )::kFrameNumberOffset;
+  } );
 }
 
 int FrameHeader::GetFrameTypeOffset( SeekDevice::Type type )
 {
-  switch ( type ) {
-  case SeekDevice::Type::SeekThermalCompact:
-    return 20;
-  case SeekDevice::Type::SeekThermalCompactPro:
-  case SeekDevice::Type::SeekThermalNano300:
-    return 4;
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "GetFrameTypeOffset not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "GetFrameTypeOffset", []( auto traits ) {
+    return decltype( traits )::kFrameTypeOffset;
+  } );
 }
 
 size_t FrameHeader::GetMinHeaderSize( SeekDevice::Type type )
 {
-  switch ( type ) {
-  case SeekDevice::Type::SeekThermalCompact:
-    return 82;
-  case SeekDevice::Type::SeekThermalCompactPro:
-  case SeekDevice::Type::SeekThermalNano300:
-    // Full header: rows 0-2 (row 2 = per-column dark reference, useful for
-    // drift analysis). Row 3 is all zeros on thermal frames, excluded.
-    return 2052;
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "GetMinHeaderSize not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "GetMinHeaderSize", []( auto traits ) {
+    return decltype( traits )::kMinHeaderSize;
+  } );
 }
 
 int FrameHeader::getFrameNumber() const
@@ -0,0 +1,595 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/detail/frame_pipeline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+constexpr int kVignetteFractionBits = VignetteCorrection::kOffsetFractionBits;
+constexpr int kNucFractionBits = NonUniformityCorrection::kFractionBits;
+constexpr int kRemapFractionBits = 8;
+constexpr int kTemporalFractionBits = 6;
+constexpr int32_t kAlphaOne = 256;
+
+//! Everything a point-wise pass reads besides the source frame.
+struct PassData {
+  const int32_t *shutter_offset;
+  const int32_t *vignette_offset;
+  const int32_t *nuc_gain;
+  const int32_t *nuc_offset;
+  int32_t drift_offset;
+  const uint16_t *temperature_lut;
+  uint16_t *counts;
+  float *temperature;
+  float temperature_offset;
+  float temperature_scale;
+  int32_t *temporal_history;
+  int32_t temporal_alpha_min;
+  int32_t temporal_slope;
+  int32_t temporal_noise_threshold;
+  int32_t temporal_motion_threshold;
+};
+
+/*!
+ * One fused per-pixel pass over the point-wise stages in `Stages`. Each stage
+ * keeps the clamp of its standalone version, so the result matches running
+ * the stages one after the other. `source` may alias `frame`.
+ */
+template<unsigned Stages>
+void pointPass( const uint16_t *source, uint16_t *frame, size_t count, const PassData &data )
+{
+  const int32_t *__restrict__ shutter_offset = data.shutter_offset;
+  const int32_t *__restrict__ vignette_offset = data.vignette_offset;
+  const int32_t *__restrict__ nuc_gain = data.nuc_gain;
+  const int32_t *__restrict__ nuc_offset = data.nuc_offset;
+  const uint16_t *__restrict__ temperature_lut = data.temperature_lut;
+  uint16_t *__restrict__ counts = data.counts;
+  float *__restrict__ temperature = data.temperature;
+  int32_t *__restrict__ history = data.temporal_history;
+  for ( size_t i = 0; i < count; ++i ) {
+    int32_t v = source[i];
+    if constexpr ( ( Stages & FramePipeline::kFlatField ) != 0 ) {
+      v = std::clamp( v + shutter_offset[i], 0, 0xFFFF );
+    }
+    if constexpr ( ( Stages & FramePipeline::kVignette ) != 0 ) {
+      // Offsets within VignetteCorrection::kMaxOffset keep the Q8 sum in range.
+      v = std::clamp( ( ( v << kVignetteFractionBits ) + vignette_offset[i] ) >>
+                          kVignetteFractionBits,
+                      0, 0xFFFF );
+    }
+    if constexpr ( ( Stages & FramePipeline::kNonUniformity ) != 0 ) {
+      // Gains below 4 and offsets within 2^17 counts keep the Q12 sum in range.
+      v = std::clamp( ( v * nuc_gain[i] + nuc_offset[i] + ( 1 << ( kNucFractionBits - 1 ) ) ) >>
+                          kNucFractionBits,
+                      0, 0xFFFF );
+    }
+    if constexpr ( ( Stages & FramePipeline::kDrift ) != 0 ) {
+      v = std::clamp( v - data.drift_offset, 0, 0xFFFF );
+    }
+    if constexpr ( ( Stages & FramePipeline::kTemporalFilter ) != 0 ) {
+      // Recursive blend in Q6 with a blend factor that ramps from alpha_min
+      // to one between the noise and motion thresholds of |value - history|.
+      const int32_t y = history[i];
+      const int32_t delta = ( v << kTemporalFractionBits ) - y;
+      const int32_t distance =
+          std::clamp( std::abs( delta ) >> kTemporalFractionBits, data.temporal_noise_threshold,
+                      data.temporal_motion_threshold );
+      const int32_t alpha = std::min(
+          kAlphaOne, data.temporal_alpha_min +
+                         ( ( ( distance - data.temporal_noise_threshold ) * data.temporal_slope ) >>
+                           8 ) );
+      const int32_t filtered = y + ( ( delta * alpha ) >> 8 );
+      history[i] = filtered;
+      v = ( filtered + ( 1 << ( kTemporalFractionBits - 1 ) ) ) >> kTemporalFractionBits;
+    }
+    if constexpr ( ( Stages & FramePipeline::kCounts ) != 0 ) {
+      counts[i] = static_cast<uint16_t>( v );
+    }
+    if constexpr ( ( Stages & FramePipeline::kTemperatureFloat ) != 0 ) {
+      temperature[i] = data.temperature_offset + data.temperature_scale * static_cast<float>( v );
+    }
+    if constexpr ( ( Stages & FramePipeline::kTemperature ) != 0 ) {
+      v = temperature_lut[v];
+    }
+    frame[i] = static_cast<uint16_t>( v );
+  }
+}
+
+using PassKernel = void ( * )( const uint16_t *, uint16_t *, size_t, const PassData & );
+
+constexpr unsigned kPointStages =
+    FramePipeline::kFlatField | FramePipeline::kVignette | FramePipeline::kNonUniformity |
+    FramePipeline::kDrift | FramePipeline::kTemporalFilter | FramePipeline::kCounts |
+    FramePipeline::kTemperatureFloat | FramePipeline::kTemperature;
+
+template<unsigned... Stages>
+constexpr std::array<PassKernel, sizeof...( Stages )>
+makePassTable( std::integer_sequence<unsigned, Stages...> )
+{
+  return { { &pointPass<Stages & kPointStages>... } };
+}
+
+//! Run the fused pass for the point-wise `stages`; a plain copy if there are none.
+void runPass( unsigned stages, const uint16_t *source, uint16_t *frame, size_t count,
+              const PassData &data )
+{
+  static constexpr auto kPasses =
+      makePassTable( std::make_integer_sequence<unsigned, FramePipeline::kAllStages + 1>() );
+  if ( stages != 0 ) {
+    kPasses[stages]( source, frame, count, data );
+  } else if ( source != frame ) {
+    std::copy( source, source + count, frame );
+  }
+}
+
+/*!
+ * Build the remap table of `region` from the Q8 sensor positions `source` of
+ * a frame `frame_width` wide. Sources outside the region are clamped to it.
+ * With a processing window this only affects the halo, which covers
+ * distortionRadius().
+ */
+void buildRemap( const int32_t *source, int frame_width, const RegionOfInterest &region,
+                 FramePipeline::RemapTable &remap )
+{
+  const int width = region.width;
+  const int height = region.height;
+  remap.index.clear();
+  remap.weight_x.clear();
+  remap.weight_y.clear();
+  remap.halo = 0;
+  if ( width < 2 || height < 2 )
+    return;
+  constexpr int one = 1 << kRemapFractionBits;
+  const size_t count = static_cast<size_t>( width ) * height;
+  remap.index.resize( count );
+  remap.weight_x.resize( count );
+  remap.weight_y.resize( count );
+  const int32_t max_x = ( width - 1 ) * one;
+  const int32_t max_y = ( height - 1 ) * one;
+  for ( int y = 0; y < height; ++y ) {
+    const int32_t *row =
+        source + 2 * ( static_cast<size_t>( y + region.y ) * frame_width + region.x );
+    for ( int x = 0; x < width; ++x ) {
+      const int32_t sx = std::clamp( row[2 * x] - region.x * one, 0, max_x );
+      const int32_t sy = std::clamp( row[2 * x + 1] - region.y * one, 0, max_y );
+      // On the last row or column the weight of the next pixel is one or zero.
+      const int x0 = std::min( sx >> kRemapFractionBits, width - 2 );
+      const int y0 = std::min( sy >> kRemapFractionBits, height - 2 );
+      const size_t i = static_cast<size_t>( y ) * width + x;
+      remap.index[i] = y0 * width + x0;
+      remap.weight_x[i] = static_cast<uint16_t>( sx - x0 * one );
+      remap.weight_y[i] = static_cast<uint16_t>( sy - y0 * one );
+      remap.halo = std::max( { remap.halo, y - y0, y0 + 1 - y } );
+    }
+  }
+}
+
+std::shared_ptr<const FramePipeline::DistortionTable>
+compileDistortion( const DistortionCorrection &distortion, int width, int height )
+{
+  if ( !distortion.valid() || width < 2 || height < 2 )
+    return nullptr;
+  auto table = std::make_shared<FramePipeline::DistortionTable>();
+  constexpr int one = 1 << kRemapFractionBits;
+  const int32_t max_x = ( width - 1 ) * one;
+  const int32_t max_y = ( height - 1 ) * one;
+  table->source.resize( 2 * static_cast<size_t>( width ) * height );
+  int32_t *source = table->source.data();
+  double radius = 0.0;
+  for ( int y = 0; y < height; ++y ) {
+    for ( int x = 0; x < width; ++x ) {
+      double sx, sy;
+      distortion.distort( x, y, sx, sy );
+      const int32_t qx = std::clamp<int32_t>( std::lround( sx * one ), 0, max_x );
+      const int32_t qy = std::clamp<int32_t>( std::lround( sy * one ), 0, max_y );
+      *source++ = qx;
+      *source++ = qy;
+      radius = std::max(
+          { radius, std::abs( qx / double( one ) - x ), std::abs( qy / double( one ) - y ) } );
+    }
+  }
+  // The bilinear interpolation also reads the next pixel.
+  table->radius = static_cast<int>( std::ceil( radius ) ) + 1;
+  buildRemap( table->source.data(), width, { 0, 0, width, height }, table->remap );
+  return table;
+}
+
+void checkFrameSize( int width, int height, int frame_width, int frame_height, const char *name )
+{
+  if ( width != frame_width || height != frame_height )
+    throw std::invalid_argument( std::string( name ) + " dimensions do not match the frame" );
+}
+
+} // namespace
+
+class FramePipeline::BuiltinStage : public ProcessingStage
+{
+public:
+  BuiltinStage( FramePipeline &pipeline, const char *name, unsigned stages )
+      : pipeline_( pipeline ), name_( name ), stages_( stages )
+  {
+  }
+
+  const char *name() const noexcept override { return name_; }
+
+  int halo() const noexcept override
+  {
+    if ( stages_ & kDeadPixels )
+      return 1;
+    if ( stages_ & kSpatialFilter )
+      return pipeline_.spatial_filter_.radius();
+    if ( stages_ & kDistortion )
+      return pipeline_.remap_ != nullptr ? pipeline_.remap_->halo : 0;
+    return 0;
+  }
+
+  bool inPlace() const noexcept override
+  {
+    return ( stages_ & ( kSpatialFilter | kDistortion ) ) == 0;
+  }
+
+  bool enabled() const noexcept override { return ( pipeline_.active_ & stages_ ) != 0; }
+
+  void process( const StageRows &rows ) override
+  {
+    if ( stages_ & kDeadPixels ) {
+      pipeline_.dead_pixels_->applyRows( rows.input, rows.output, rows.row_begin, rows.row_end );
+    } else if ( stages_ & kSpatialFilter ) {
+      pipeline_.spatial_filter_.filterRows( rows.input, rows.output, rows.width, rows.height,
+                                            rows.row_begin, rows.row_end );
+    } else if ( stages_ & kDistortion ) {
+      pipeline_.remapRows( rows.input, rows.output, rows.row_begin, rows.row_end );
+    } else {
+      pipeline_.runPointRows( pipeline_.active_ & stages_, rows.input, rows.output, rows.row_begin,
+                              rows.row_end );
+    }
+  }
+
+  unsigned stages() const noexcept { return stages_; }
+
+private:
+  FramePipeline &pipeline_;
+  const char *name_;
+  unsigned stages_;
+};
+
+class FramePipeline::FusedPointStage : public ProcessingStage
+{
+public:
+  explicit FusedPointStage( FramePipeline &pipeline ) : pipeline_( pipeline ) { }
+
+  const char *name() const noexcept override { return name_.c_str(); }
+
+  void process( const StageRows &rows ) override
+  {
+    pipeline_.runPointRows( pipeline_.active_ & stages_, rows.input, rows.output, rows.row_begin,
+                            rows.row_end );
+  }
+
+  void configure( unsigned stages )
+  {
+    if ( stages == stages_ )
+      return;
+    stages_ = stages;
+    name_.clear();
+    for ( const ProcessingStage::SharedPtr &stage : pipeline_.builtin_stages_ ) {
+      if ( ( pipeline_.pointStages( stage.get() ) & stages ) == 0 )
+        continue;
+      if ( !name_.empty() )
+        name_ += '+';
+      name_ += stage->name();
+    }
+  }
+
+private:
+  FramePipeline &pipeline_;
+  unsigned stages_ = 0;
+  std::string name_;
+};
+
+FramePipeline::FramePipeline( int width, int height )
+    : frame_width_( width ), frame_height_( height ), region_{ 0, 0, width, height },
+      width_( width ), height_( height ), calibration_( std::make_shared<CompiledCalibration>() )
+{
+  builtin_stages_ = {
+      std::make_shared<BuiltinStage>( *this, "flat_field", kFlatField ),
+      std::make_shared<BuiltinStage>( *this, "dead_pixels", kDeadPixels ),
+      std::make_shared<BuiltinStage>( *this, "vignette", kVignette ),
+      std::make_shared<BuiltinStage>( *this, "non_uniformity", kNonUniformity ),
+      std::make_shared<BuiltinStage>( *this, "drift", kDrift ),
+      std::make_shared<BuiltinStage>( *this, "spatial_filter", kSpatialFilter ),
+      std::make_shared<BuiltinStage>( *this, "distortion", kDistortion ),
+      std::make_shared<BuiltinStage>( *this, "temporal_filter", kTemporalFilter ),
+      std::make_shared<BuiltinStage>( *this, "temperature",
+                                      kCounts | kTemperatureFloat | kTemperature ),
+  };
+  for ( size_t i = 0; i < kFusedStageSlots; ++i ) {
+    fused_stages_.push_back( std::make_shared<FusedPointStage>( *this ) );
+  }
+}
+
+unsigned FramePipeline::pointStages( const ProcessingStage *stage ) const noexcept
+{
+  for ( const ProcessingStage::SharedPtr &builtin : builtin_stages_ ) {
+    if ( builtin.get() == stage )
+      return static_cast<const BuiltinStage *>( stage )->stages() & kPointStages;
+  }
+  return 0;
+}
+
+ProcessingStage *FramePipeline::fusedPointStage( size_t slot, unsigned stages )
+{
+  auto *stage = static_cast<FusedPointStage *>( fused_stages_.at( slot ).get() );
+  stage->configure( stages );
+  return stage;
+}
+
+std::shared_ptr<const FramePipeline::CompiledCalibration>
+FramePipeline::compile( const CameraCalibration &calibration, int width, int height )
+{
+  auto compiled = std::make_shared<CompiledCalibration>();
+  if ( const auto &mask = calibration.dead_pixels; mask && mask->deadPixelCount() > 0 ) {
+    checkFrameSize( mask->width(), mask->height(), width, height, "Dead-pixel mask" );
+    compiled->dead_pixels = std::make_shared<const DeadPixelMask>( *mask );
+    compiled->stages |= kDeadPixels;
+  }
+  if ( const auto &vignette = calibration.vignette;
+       vignette && !vignette->coeffs.empty() && vignette->r2_max > 0.0 ) {
+    checkFrameSize( vignette->width, vignette->height, width, height, "Vignette correction" );
+    if ( vignette->offsets != nullptr ) {
+      compiled->vignette_offset = vignette->offsets;
+    } else {
+      auto table = std::make_shared<std::vector<int32_t>>( vignette->computeOffsets() );
+      compiled->vignette_offset = std::shared_ptr<const int32_t>( table, table->data() );
+    }
+    compiled->stages |= kVignette;
+  }
+  if ( const auto &nuc = calibration.non_uniformity; nuc && nuc->gainTable() != nullptr ) {
+    checkFrameSize( nuc->width(), nuc->height(), width, height, "Non-uniformity correction" );
+    compiled->non_uniformity = std::make_shared<const NonUniformityCorrection>( *nuc );
+    compiled->stages |= kNonUniformity;
+  }
+  if ( const auto &distortion = calibration.distortion; distortion ) {
+    checkFrameSize( distortion->width, distortion->height, width, height, "Distortion model" );
+    compiled->distortion = compileDistortion( *distortion, width, height );
+    if ( compiled->distortion != nullptr )
+      compiled->stages |= kDistortion;
+  }
+  if ( calibration.temperature ) {
+    compiled->temperature = compileTemperature( *calibration.temperature );
+    compiled->stages |= kTemperature | kTemperatureFloat;
+  }
+  return compiled;
+}
+
+std::shared_ptr<const FramePipeline::TemperatureTable>
+FramePipeline::compileTemperature( const TemperatureCalibration &temperature )
+{
+  auto table = std::make_shared<TemperatureTable>();
+  table->c0 = static_cast<float>( temperature.c0 );
+  table->c1 = static_cast<float>( temperature.c1 );
+  table->lut.resize( 0x10000 );
+  for ( uint32_t raw = 0; raw <= 0xFFFF; ++raw ) {
+    table->lut[raw] = temperature.apply( static_cast<uint16_t>( raw ) );
+  }
+  return table;
+}
+
+void FramePipeline::setCalibration( std::shared_ptr<const CompiledCalibration> calibration )
+{
+  calibration_ = calibration != nullptr ? std::move( calibration )
+                                        : std::make_shared<CompiledCalibration>();
+  updateRegionTables();
+}
+
+void FramePipeline::setTemperature( std::shared_ptr<const TemperatureTable> temperature )
+{
+  // The other components are shared with the previous calibration, so the
+  // region cuts stay valid.
+  auto calibration = std::make_shared<CompiledCalibration>( *calibration_ );
+  calibration->stages &= ~( kTemperature | kTemperatureFloat );
+  if ( temperature != nullptr )
+    calibration->stages |= kTemperature | kTemperatureFloat;
+  calibration->temperature = std::move( temperature );
+  calibration_ = std::move( calibration );
+}
+
+void FramePipeline::setTemperature( const TemperatureCalibration *temperature )
+{
+  setTemperature( temperature != nullptr ? compileTemperature( *temperature ) : nullptr );
+}
+
+void FramePipeline::setRegion( const RegionOfInterest &region )
+{
+  const int x0 = std::max( region.x, 0 );
+  const int y0 = std::max( region.y, 0 );
+  const int x1 = std::min( region.x + region.width, frame_width_ );
+  const int y1 = std::min( region.y + region.height, frame_height_ );
+  const RegionOfInterest clipped = x1 <= x0 || y1 <= y0
+                                      ? RegionOfInterest{ 0, 0, frame_width_, frame_height_ }
+                                      : RegionOfInterest{ x0, y0, x1 - x0, y1 - y0 };
+  if ( clipped.x == region_.x && clipped.y == region_.y && clipped.width == region_.width &&
+       clipped.height == region_.height )
+    return;
+  region_ = clipped;
+  width_ = region_.width;
+  height_ = region_.height;
+  updateRegionTables();
+}
+
+void FramePipeline::updateRegionTables()
+{
+  const bool full = width_ == frame_width_ && height_ == frame_height_;
+  const size_t count = static_cast<size_t>( width_ ) * height_;
+  // Copy the region's rows of a per-pixel table of the frame.
+  const auto cut = [this, count]( const int32_t *table, std::vector<int32_t> &out ) {
+    out.resize( count );
+    for ( int y = 0; y < height_; ++y ) {
+      const int32_t *row = table + static_cast<size_t>( y + region_.y ) * frame_width_ + region_.x;
+      std::copy( row, row + width_, out.begin() + static_cast<size_t>( y ) * width_ );
+    }
+    return out.data();
+  };
+
+  dead_pixels_ = calibration_->dead_pixels.get();
+  if ( dead_pixels_ != nullptr && !full ) {
+    // Neighbours outside the region are dropped, which only affects the
+    // region's border pixels.
+    std::vector<std::pair<int, int>> dead;
+    for ( const DeadPixelEntry &entry : dead_pixels_->entries() ) {
+      const int x = static_cast<int>( entry.index % frame_width_ ) - region_.x;
+      const int y = static_cast<int>( entry.index / frame_width_ ) - region_.y;
+      if ( x >= 0 && x < width_ && y >= 0 && y < height_ )
+        dead.emplace_back( x, y );
+    }
+    region_dead_pixels_ = DeadPixelMask( width_, height_, dead );
+    dead_pixels_ = dead.empty() ? nullptr : &region_dead_pixels_;
+  }
+
+  vignette_offset_ = calibration_->vignette_offset.get();
+  if ( vignette_offset_ != nullptr && !full )
+    vignette_offset_ = cut( vignette_offset_, region_vignette_offset_ );
+
+  nuc_gain_ = nullptr;
+  nuc_offset_ = nullptr;
+  if ( const NonUniformityCorrection *nuc = calibration_->non_uniformity.get(); nuc != nullptr ) {
+    nuc_gain_ = full ? nuc->gainTable() : cut( nuc->gainTable(), region_nuc_gain_ );
+    nuc_offset_ = full ? nuc->offsetTable() : cut( nuc->offsetTable(), region_nuc_offset_ );
+  }
+
+  remap_ = nullptr;
+  if ( const DistortionTable *distortion = calibration_->distortion.get(); distortion != nullptr ) {
+    if ( full ) {
+      remap_ = &distortion->remap;
+    } else {
+      buildRemap( distortion->source.data(), frame_width_, region_, region_remap_ );
+      remap_ = region_remap_.index.empty() ? nullptr : &region_remap_;
+    }
+  }
+}
+
+void FramePipeline::remapRows( const uint16_t *input, uint16_t *output, int row_begin,
+                               int row_end ) const
+{
+  constexpr uint32_t one = 1u << kRemapFractionBits;
+  constexpr uint32_t round = 1u << ( 2 * kRemapFractionBits - 1 );
+  const int32_t *__restrict__ index = remap_->index.data();
+  const uint16_t *__restrict__ weight_x = remap_->weight_x.data();
+  const uint16_t *__restrict__ weight_y = remap_->weight_y.data();
+  const size_t stride = width_;
+  const size_t end = static_cast<size_t>( row_end ) * width_;
+  // A gather of four neighbours per pixel; the weights are precomputed so no
+  // model is evaluated per frame. The Q8 products of 16-bit values stay
+  // below 2^32.
+  for ( size_t i = static_cast<size_t>( row_begin ) * width_; i < end; ++i ) {
+    const uint16_t *p = input + index[i];
+    const uint32_t wx = weight_x[i];
+    const uint32_t wy = weight_y[i];
+    const uint32_t top = p[0] * ( one - wx ) + p[1] * wx;
+    const uint32_t bottom = p[stride] * ( one - wx ) + p[stride + 1] * wx;
+    output[i] = static_cast<uint16_t>( ( top * ( one - wy ) + bottom * wy + round ) >>
+                                       ( 2 * kRemapFractionBits ) );
+  }
+}
+
+void FramePipeline::setTemporalFilter( const TemporalFilterSettings *settings )
+{
+  if ( settings == nullptr ) {
+    available_ &= ~kTemporalFilter;
+    return;
+  }
+  const double strength = std::clamp( settings->strength, 0.0, 1.0 );
+  temporal_alpha_min_ =
+      std::max<int32_t>( 1, static_cast<int32_t>( std::lround( ( 1.0 - strength ) * kAlphaOne ) ) );
+  temporal_noise_threshold_ = std::max( 0, settings->noise_threshold );
+  temporal_motion_threshold_ =
+      std::max( temporal_noise_threshold_ + 1, settings->motion_threshold );
+  // Q8 increase of alpha per count above the noise threshold; the product with
+  // the clamped distance stays below 2^17.
+  temporal_slope_ = ( ( kAlphaOne - temporal_alpha_min_ ) << 8 ) /
+                        ( temporal_motion_threshold_ - temporal_noise_threshold_ ) +
+                    1;
+  available_ |= kTemporalFilter;
+}
+
+void FramePipeline::setSpatialFilter( const SpatialFilterSettings *settings )
+{
+  if ( settings == nullptr ) {
+    available_ &= ~kSpatialFilter;
+    return;
+  }
+  spatial_filter_ = BilateralFilter( *settings );
+  available_ |= kSpatialFilter;
+}
+
+unsigned FramePipeline::availableStages() const noexcept
+{
+  // The calibrated stages whose tables are present in the region.
+  unsigned stages = available_ | ( calibration_->stages & ( kTemperature | kTemperatureFloat ) );
+  if ( dead_pixels_ != nullptr )
+    stages |= kDeadPixels;
+  if ( vignette_offset_ != nullptr )
+    stages |= kVignette;
+  if ( nuc_gain_ != nullptr )
+    stages |= kNonUniformity;
+  if ( remap_ != nullptr )
+    stages |= kDistortion;
+  return stages;
+}
+
+void FramePipeline::prepare( unsigned stages, const FrameInputs &inputs,
+                             const FrameOutputs &outputs )
+{
+  stages &= availableStages();
+  if ( inputs.shutter_offset == nullptr )
+    stages &= ~kFlatField;
+  if ( outputs.temperature == nullptr )
+    stages &= ~kTemperatureFloat;
+  if ( inputs.temporal_history == nullptr )
+    stages &= ~kTemporalFilter;
+  // Separate corrected counts only make sense next to a centi-Kelvin frame.
+  if ( outputs.counts == nullptr || ( stages & kTemperature ) == 0 )
+    stages &= ~kCounts;
+  active_ = stages;
+  inputs_ = inputs;
+  outputs_ = outputs;
+}
+
+void FramePipeline::runPointRows( unsigned stages, const uint16_t *input, uint16_t *output,
+                                  int row_begin, int row_end ) const
+{
+  const size_t offset = static_cast<size_t>( row_begin ) * width_;
+  const size_t count = static_cast<size_t>( row_end - row_begin ) * width_;
+  const auto shift = [offset]( auto *data ) { return data != nullptr ? data + offset : data; };
+  const float zero = outputs_.temperature_unit == TemperatureUnit::Kelvin ? 273.15f : 0.0f;
+  const TemperatureTable *temperature = calibration_->temperature.get();
+  const PassData data{ shift( inputs_.shutter_offset ),
+                       vignette_offset_ == nullptr ? nullptr : vignette_offset_ + offset,
+                       nuc_gain_ == nullptr ? nullptr : nuc_gain_ + offset,
+                       nuc_offset_ == nullptr ? nullptr : nuc_offset_ + offset,
+                       inputs_.drift_offset,
+                       temperature != nullptr ? temperature->lut.data() : nullptr,
+                       shift( outputs_.counts ),
+                       shift( outputs_.temperature ),
+                       temperature != nullptr ? temperature->c0 + zero : 0.0f,
+                       temperature != nullptr ? temperature->c1 : 1.0f,
+                       shift( inputs_.temporal_history ),
+                       inputs_.temporal_reset ? kAlphaOne : temporal_alpha_min_,
+                       temporal_slope_,
+                       temporal_noise_threshold_,
+                       temporal_motion_threshold_ };
+  runPass( stages, input + offset, output + offset, count, data );
+}
+
+} // namespace openseekthermal
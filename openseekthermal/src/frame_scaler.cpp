@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/frame_scaler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+constexpr int kWeightBits = 12;
+//! Fractional bits kept between the horizontal and the vertical pass. With
+//! Q12 weights, whose absolute sum stays below 1.25, the vertical sums stay
+//! within int32.
+constexpr int kIntermediateBits = 2;
+
+double kernel( ScalingFilter filter, double distance )
+{
+  const double d = std::abs( distance );
+  if ( filter == ScalingFilter::Bilinear )
+    return d < 1.0 ? 1.0 - d : 0.0;
+  // Catmull-Rom, i.e. Keys' cubic with a = -0.5.
+  constexpr double a = -0.5;
+  if ( d <= 1.0 )
+    return ( ( a + 2.0 ) * d - ( a + 3.0 ) ) * d * d + 1.0;
+  if ( d < 2.0 )
+    return ( ( a * d - 5.0 * a ) * d + 8.0 * a ) * d - 4.0 * a;
+  return 0.0;
+}
+
+template<int Taps>
+void filterColumns( const uint16_t *__restrict__ row, const int *__restrict__ index,
+                    const int32_t *__restrict__ weight, int width, int32_t *__restrict__ output )
+{
+  constexpr int shift = kWeightBits - kIntermediateBits;
+  constexpr int32_t round = 1 << ( shift - 1 );
+  for ( int x = 0; x < width; ++x ) {
+    int32_t sum = round;
+    for ( int t = 0; t < Taps; ++t ) sum += weight[x * Taps + t] * row[index[x * Taps + t]];
+    output[x] = sum >> shift;
+  }
+}
+
+template<int Taps>
+void combineRows( const int32_t *const *rows, const int32_t *weights, int width,
+                  uint16_t *__restrict__ output )
+{
+  constexpr int shift = kWeightBits + kIntermediateBits;
+  constexpr int32_t round = 1 << ( shift - 1 );
+  const int32_t *__restrict__ r0 = rows[0];
+  const int32_t *__restrict__ r1 = rows[1];
+  const int32_t *__restrict__ r2 = rows[Taps > 2 ? 2 : 0];
+  const int32_t *__restrict__ r3 = rows[Taps > 2 ? 3 : 0];
+  const int32_t w0 = weights[0];
+  const int32_t w1 = weights[1];
+  const int32_t w2 = Taps > 2 ? weights[2] : 0;
+  const int32_t w3 = Taps > 2 ? weights[3] : 0;
+  for ( int x = 0; x < width; ++x ) {
+    int32_t sum = w0 * r0[x] + w1 * r1[x] + round;
+    if constexpr ( Taps > 2 )
+      sum += w2 * r2[x] + w3 * r3[x];
+    output[x] = static_cast<uint16_t>( std::clamp( sum >> shift, 0, 0xFFFF ) );
+  }
+}
+
+} // namespace
+
+FrameScaler::FrameScaler( int source_width, int source_height, int width, int height,
+                          ScalingFilter filter )
+    : source_width_( source_width ), source_height_( source_height ), width_( width ),
+      height_( height ), filter_( filter ), taps_( filter == ScalingFilter::Bicubic ? 4 : 2 )
+{
+  if ( source_width <= 0 || source_height <= 0 || width <= 0 || height <= 0 )
+    throw std::invalid_argument( "Frame scaler sizes must be positive" );
+  columns_ = computeTaps( source_width, width, taps_, filter );
+  rows_ = computeTaps( source_height, height, taps_, filter );
+  ring_.resize( static_cast<size_t>( taps_ ) * width );
+  ring_row_.assign( taps_, -1 );
+}
+
+FrameScaler::Taps FrameScaler::computeTaps( int source_size, int size, int taps,
+                                            ScalingFilter filter )
+{
+  Taps result;
+  result.index.resize( static_cast<size_t>( size ) * taps );
+  result.weight.resize( static_cast<size_t>( size ) * taps );
+  const double ratio = static_cast<double>( source_size ) / size;
+  for ( int i = 0; i < size; ++i ) {
+    const double center = ( i + 0.5 ) * ratio - 0.5;
+    const int first = static_cast<int>( std::floor( center ) ) - ( taps / 2 - 1 );
+    double weights[4];
+    double total = 0.0;
+    for ( int t = 0; t < taps; ++t ) {
+      weights[t] = kernel( filter, center - ( first + t ) );
+      total += weights[t];
+    }
+    // Quantize so the weights sum to exactly one; the rounding error goes to
+    // the largest tap.
+    int32_t *weight = result.weight.data() + static_cast<size_t>( i ) * taps;
+    int *index = result.index.data() + static_cast<size_t>( i ) * taps;
+    int32_t sum = 0;
+    int largest = 0;
+    for ( int t = 0; t < taps; ++t ) {
+      weight[t] = static_cast<int32_t>( std::lround( weights[t] / total * ( 1 << kWeightBits ) ) );
+      sum += weight[t];
+      if ( weight[t] > weight[largest] )
+        largest = t;
+      index[t] = std::clamp( first + t, 0, source_size - 1 );
+    }
+    weight[largest] += ( 1 << kWeightBits ) - sum;
+  }
+  return result;
+}
+
+void FrameScaler::filterRow( const uint16_t *row, int y )
+{
+  const int slot = y % taps_;
+  int32_t *out = ring_.data() + static_cast<size_t>( slot ) * width_;
+  if ( taps_ == 4 )
+    filterColumns<4>( row, columns_.index.data(), columns_.weight.data(), width_, out );
+  else
+    filterColumns<2>( row, columns_.index.data(), columns_.weight.data(), width_, out );
+  ring_row_[slot] = y;
+}
+
+void FrameScaler::scale( const uint16_t *source, size_t source_stride, uint16_t *output,
+                         size_t output_stride )
+{
+  std::fill( ring_row_.begin(), ring_row_.end(), -1 );
+  const int32_t *rows[4];
+  for ( int y = 0; y < height_; ++y ) {
+    const int *index = rows_.index.data() + static_cast<size_t>( y ) * taps_;
+    for ( int t = 0; t < taps_; ++t ) {
+      const int slot = index[t] % taps_;
+      if ( ring_row_[slot] != index[t] )
+        filterRow( source + static_cast<size_t>( index[t] ) * source_stride, index[t] );
+      rows[t] = ring_.data() + static_cast<size_t>( slot ) * width_;
+    }
+    const int32_t *weights = rows_.weight.data() + static_cast<size_t>( y ) * taps_;
+    uint16_t *out = output + static_cast<size_t>( y ) * output_stride;
+    if ( taps_ == 4 )
+      combineRows<4>( rows, weights, width_, out );
+    else
+      combineRows<2>( rows, weights, width_, out );
+  }
+}
+
+} // namespace openseekthermal
@@ -0,0 +1,76 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/detail/frame_stats_accumulator.hpp"
+
+#include <algorithm>
+
+namespace openseekthermal
+{
+
+double FrameStats::percentile( double fraction ) const noexcept
+{
+  if ( pixel_count == 0 )
+    return 0.0;
+  const double rank = std::clamp( fraction, 0.0, 1.0 ) * static_cast<double>( pixel_count );
+  double cumulative = 0.0;
+  for ( int bin = 0; bin < kHistogramBins; ++bin ) {
+    const double count = histogram[bin];
+    if ( count > 0 && cumulative + count >= rank ) {
+      const double value = ( bin + ( rank - cumulative ) / count ) * kHistogramBinWidth;
+      return std::clamp<double>( value, min, max );
+    }
+    cumulative += count;
+  }
+  return max;
+}
+
+void FrameStatsAccumulator::reset() noexcept
+{
+  for ( auto &lane : histogram_ ) lane.fill( 0 );
+  sum_ = 0;
+  count_ = 0;
+  min_ = 0xFFFF;
+  max_ = 0;
+}
+
+void FrameStatsAccumulator::add( const uint16_t *pixels, size_t count ) noexcept
+{
+  // Min, max and sum vectorize; the histogram is a separate scalar loop over
+  // the same (cached) rows.
+  uint16_t min = min_;
+  uint16_t max = max_;
+  uint64_t sum = 0;
+  for ( size_t i = 0; i < count; ++i ) {
+    min = std::min( min, pixels[i] );
+    max = std::max( max, pixels[i] );
+    sum += pixels[i];
+  }
+  min_ = min;
+  max_ = max;
+  sum_ += sum;
+  count_ += count;
+
+  constexpr int kShift = 8; // log2( FrameStats::kHistogramBinWidth )
+  static_assert( FrameStats::kHistogramBinWidth == 1 << kShift );
+  size_t i = 0;
+  for ( ; i + kLanes <= count; i += kLanes ) {
+    for ( int lane = 0; lane < kLanes; ++lane ) ++histogram_[lane][pixels[i + lane] >> kShift];
+  }
+  for ( ; i < count; ++i ) ++histogram_[0][pixels[i] >> kShift];
+}
+
+void FrameStatsAccumulator::finish( FrameStats &stats ) const noexcept
+{
+  stats.pixel_count = count_;
+  stats.min = count_ == 0 ? 0 : min_;
+  stats.max = max_;
+  stats.mean = count_ == 0 ? 0.0 : static_cast<double>( sum_ ) / static_cast<double>( count_ );
+  for ( int bin = 0; bin < FrameStats::kHistogramBins; ++bin ) {
+    uint32_t total = 0;
+    for ( const auto &lane : histogram_ ) total += lane[bin];
+    stats.histogram[bin] = total;
+  }
+}
+
+} // namespace openseekthermal
@@ -0,0 +1,216 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/hot_spot_detector.hpp"
+
+#include <algorithm>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+constexpr int kColdChunk = 16;
+
+//! First x >= `x` of `row` whose kColdChunk block may contain a pixel at or
+//! above `threshold`, skipping whole blocks below it.
+int skipColdChunks( const uint16_t *__restrict__ row, int x, int width, uint16_t threshold )
+{
+  for ( ; x + kColdChunk <= width; x += kColdChunk ) {
+    uint16_t max = 0;
+    for ( int i = 0; i < kColdChunk; ++i ) max = std::max( max, row[x + i] );
+    if ( max >= threshold )
+      break;
+  }
+  return x;
+}
+
+} // namespace
+
+void HotSpotDetector::detect( const uint16_t *frame, int width, int height )
+{
+  addRows( frame, width, height, 0, height );
+}
+
+void HotSpotDetector::addRows( const uint16_t *frame, int width, int height, int row_begin,
+                               int row_end )
+{
+  if ( row_begin == 0 ) {
+    width_ = width;
+    height_ = height;
+    frame_settings_ = settings_;
+    frame_origin_x_ = origin_x_;
+    frame_origin_y_ = origin_y_;
+    rows_ = 0;
+    complete_ = false;
+    runs_.clear();
+    parent_.clear();
+    previous_row_begin_ = previous_row_end_ = 0;
+  }
+  if ( row_begin != rows_ || width != width_ || height != height_ || row_end > height ||
+       row_end <= row_begin )
+    return;
+
+  for ( int y = row_begin; y < row_end; ++y )
+    addRow( frame + static_cast<size_t>( y ) * width, y );
+  rows_ = row_end;
+  if ( rows_ == height_ ) {
+    finishFrame();
+    complete_ = true;
+  }
+}
+
+void HotSpotDetector::addRow( const uint16_t *row, int y )
+{
+  const uint16_t threshold = frame_settings_.threshold;
+  const int width = width_;
+  const size_t row_begin = runs_.size();
+  int x = 0;
+  while ( x < width ) {
+    x = skipColdChunks( row, x, width, threshold );
+    while ( x < width && row[x] < threshold ) ++x;
+    if ( x == width )
+      break;
+    Run run{ y, x, x, x, row[x], 0 };
+    for ( ; x < width && row[x] >= threshold; ++x ) {
+      run.sum += row[x];
+      if ( row[x] > run.peak ) {
+        run.peak = row[x];
+        run.peak_x = x;
+      }
+    }
+    run.x_end = x;
+    runs_.push_back( run );
+    parent_.push_back( static_cast<uint32_t>( runs_.size() - 1 ) );
+  }
+
+  // Runs of both rows are ordered by x, so the candidates above a run start
+  // at or after those of the run before it.
+  const int reach = frame_settings_.eight_connected ? 1 : 0;
+  size_t above = previous_row_begin_;
+  for ( size_t current = row_begin; current < runs_.size(); ++current ) {
+    const Run &run = runs_[current];
+    while ( above < previous_row_end_ && runs_[above].x_end + reach <= run.x_begin ) ++above;
+    for ( size_t candidate = above;
+          candidate < previous_row_end_ && runs_[candidate].x_begin < run.x_end + reach;
+          ++candidate ) {
+      const uint32_t a = findRoot( static_cast<uint32_t>( candidate ) );
+      const uint32_t b = findRoot( static_cast<uint32_t>( current ) );
+      // Keeping the smaller index as root makes it the region's first run.
+      if ( a < b )
+        parent_[b] = a;
+      else if ( b < a )
+        parent_[a] = b;
+    }
+  }
+  previous_row_begin_ = row_begin;
+  previous_row_end_ = runs_.size();
+}
+
+uint32_t HotSpotDetector::findRoot( uint32_t run ) noexcept
+{
+  while ( parent_[run] != run ) {
+    parent_[run] = parent_[parent_[run]];
+    run = parent_[run];
+  }
+  return run;
+}
+
+void HotSpotDetector::finishFrame()
+{
+  // mean and centroid hold the sums of values and coordinates until the
+  // division below; being integers below 2^53 they are exact as doubles.
+  hot_spots_.clear();
+  region_of_root_.resize( runs_.size() );
+  for ( size_t i = 0; i < runs_.size(); ++i ) {
+    const Run &run = runs_[i];
+    const uint32_t root = findRoot( static_cast<uint32_t>( i ) );
+    const auto length = static_cast<uint64_t>( run.x_end - run.x_begin );
+    // Roots precede the other runs of their region.
+    if ( root == i ) {
+      region_of_root_[i] = static_cast<uint32_t>( hot_spots_.size() );
+      HotSpot spot;
+      spot.x_min = run.x_begin;
+      spot.x_max = run.x_end - 1;
+      spot.y_min = spot.y_max = run.y;
+      spot.peak_x = run.peak_x;
+      spot.peak_y = run.y;
+      spot.peak = run.peak;
+      hot_spots_.push_back( spot );
+    }
+    const uint32_t region = region_of_root_[root];
+    HotSpot &spot = hot_spots_[region];
+    spot.x_min = std::min( spot.x_min, run.x_begin );
+    spot.x_max = std::max( spot.x_max, run.x_end - 1 );
+    spot.y_max = run.y;
+    spot.area += length;
+    if ( run.peak > spot.peak ) {
+      spot.peak = run.peak;
+      spot.peak_x = run.peak_x;
+      spot.peak_y = run.y;
+    }
+    spot.mean += static_cast<double>( run.sum );
+    const uint64_t x_sum = ( static_cast<uint64_t>( run.x_begin ) + run.x_end - 1 ) * length / 2;
+    spot.centroid_x += static_cast<double>( x_sum );
+    spot.centroid_y += static_cast<double>( static_cast<uint64_t>( run.y ) * length );
+  }
+
+  size_t kept = 0;
+  for ( HotSpot &spot : hot_spots_ ) {
+    if ( spot.area < frame_settings_.min_area )
+      continue;
+    const double area = static_cast<double>( spot.area );
+    spot.mean /= area;
+    spot.centroid_x = spot.centroid_x / area + frame_origin_x_;
+    spot.centroid_y = spot.centroid_y / area + frame_origin_y_;
+    spot.x_min += frame_origin_x_;
+    spot.x_max += frame_origin_x_;
+    spot.peak_x += frame_origin_x_;
+    spot.y_min += frame_origin_y_;
+    spot.y_max += frame_origin_y_;
+    spot.peak_y += frame_origin_y_;
+    hot_spots_[kept++] = spot;
+  }
+  hot_spots_.resize( kept );
+}
+
+void HotSpotStage::process( const StageRows &rows )
+{
+  passThroughRows( rows );
+  if ( rows.row_begin == 0 ) {
+    detector_.setOrigin( rows.origin_x, rows.origin_y );
+    std::lock_guard lock( mutex_ );
+    detector_.setSettings( settings_ );
+  }
+  detector_.addRows( rows.output, rows.width, rows.height, rows.row_begin, rows.row_end );
+  if ( rows.row_end != rows.height || !detector_.valid() )
+    return;
+  std::shared_ptr<const std::vector<HotSpot>> hot_spots =
+      std::make_shared<const std::vector<HotSpot>>( detector_.hotSpots() );
+  {
+    std::lock_guard lock( mutex_ );
+    hot_spots_.swap( hot_spots );
+  }
+  // The previous list, if no longer referenced, is freed outside the lock.
+}
+
+void HotSpotStage::setSettings( const HotSpotSettings &settings )
+{
+  std::lock_guard lock( mutex_ );
+  settings_ = settings;
+}
+
+HotSpotSettings HotSpotStage::settings() const
+{
+  std::lock_guard lock( mutex_ );
+  return settings_;
+}
+
+std::shared_ptr<const std::vector<HotSpot>> HotSpotStage::hotSpots() const
+{
+  std::lock_guard lock( mutex_ );
+  return hot_spots_;
+}
+
+} // namespace openseekthermal
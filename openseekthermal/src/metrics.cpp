@@ -0,0 +1,267 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/metrics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+//! Frame counter jumps larger than this are a restart, not dropped frames.
+constexpr int kMaxFrameGap = 1000;
+//! Weight of a new interval in the smoothed frame interval, as a shift.
+constexpr int kIntervalSmoothingShift = 3;
+
+void writeSummary( std::ostream &out, const char *metric, const LatencySnapshot &latency,
+                   const std::string &labels )
+{
+  const char *separator = labels.empty() ? "" : ",";
+  out << metric << "{" << labels << separator << "quantile=\"0.5\"} " << latency.p50_ms / 1e3
+      << "\n";
+  out << metric << "{" << labels << separator << "quantile=\"0.9\"} " << latency.p90_ms / 1e3
+      << "\n";
+  out << metric << "{" << labels << separator << "quantile=\"0.99\"} " << latency.p99_ms / 1e3
+      << "\n";
+  out << metric << "_sum{" << labels << "} " << latency.sum_ms / 1e3 << "\n";
+  out << metric << "_count{" << labels << "} " << latency.count << "\n";
+}
+
+std::string escapeLabel( const std::string &value )
+{
+  std::string result;
+  result.reserve( value.size() );
+  for ( char c : value ) {
+    if ( c == '\\' || c == '"' )
+      result += '\\';
+    if ( c == '\n' ) {
+      result += "\\n";
+      continue;
+    }
+    result += c;
+  }
+  return result;
+}
+
+} // namespace
+
+size_t LatencyHistogram::bucketIndex( uint64_t ns ) noexcept
+{
+  constexpr uint64_t kLinear = uint64_t{ 1 } << kSubBucketBits;
+  if ( ns < kLinear )
+    return static_cast<size_t>( ns );
+  const int exponent = std::min( 63 - __builtin_clzll( ns ), kMaxExponent );
+  if ( exponent == kMaxExponent && ( ns >> kMaxExponent ) > 1 )
+    return kBucketCount - 1;
+  const uint64_t sub = ( ns >> ( exponent - kSubBucketBits ) ) & ( kLinear - 1 );
+  return ( static_cast<size_t>( exponent - kSubBucketBits + 1 ) << kSubBucketBits ) + sub;
+}
+
+double LatencyHistogram::bucketValue( size_t index ) noexcept
+{
+  constexpr size_t kLinear = size_t{ 1 } << kSubBucketBits;
+  if ( index < kLinear )
+    return static_cast<double>( index );
+  const int exponent = static_cast<int>( index >> kSubBucketBits ) + kSubBucketBits - 1;
+  const double width = static_cast<double>( uint64_t{ 1 } << ( exponent - kSubBucketBits ) );
+  const double lower = static_cast<double>( kLinear + ( index & ( kLinear - 1 ) ) ) * width;
+  return lower + width / 2;
+}
+
+void LatencyHistogram::record( std::chrono::nanoseconds duration ) noexcept
+{
+  const uint64_t ns = duration.count() < 0 ? 0 : static_cast<uint64_t>( duration.count() );
+  buckets_[bucketIndex( ns )].fetch_add( 1, std::memory_order_relaxed );
+  sum_ns_.fetch_add( ns, std::memory_order_relaxed );
+  uint64_t max = max_ns_.load( std::memory_order_relaxed );
+  while ( ns > max && !max_ns_.compare_exchange_weak( max, ns, std::memory_order_relaxed ) ) { }
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const
+{
+  LatencySnapshot result;
+  result.name = name_;
+  std::array<uint64_t, kBucketCount> counts;
+  uint64_t total = 0;
+  for ( size_t i = 0; i < kBucketCount; ++i ) {
+    counts[i] = buckets_[i].load( std::memory_order_relaxed );
+    total += counts[i];
+  }
+  // The bucket total keeps the quantiles consistent with the buckets read
+  // even while another thread records.
+  result.count = total;
+  result.sum_ms = static_cast<double>( sum_ns_.load( std::memory_order_relaxed ) ) / 1e6;
+  result.max_ms = static_cast<double>( max_ns_.load( std::memory_order_relaxed ) ) / 1e6;
+  if ( total == 0 )
+    return result;
+  const auto quantile = [&]( double q ) {
+    const auto rank = static_cast<uint64_t>( q * static_cast<double>( total - 1 ) ) + 1;
+    uint64_t cumulative = 0;
+    for ( size_t i = 0; i < kBucketCount; ++i ) {
+      cumulative += counts[i];
+      if ( cumulative >= rank )
+        return std::min( bucketValue( i ) / 1e6, result.max_ms );
+    }
+    return result.max_ms;
+  };
+  result.p50_ms = quantile( 0.5 );
+  result.p90_ms = quantile( 0.9 );
+  result.p99_ms = quantile( 0.99 );
+  return result;
+}
+
+void LatencyHistogram::reset() noexcept
+{
+  for ( auto &bucket : buckets_ ) bucket.store( 0, std::memory_order_relaxed );
+  sum_ns_.store( 0, std::memory_order_relaxed );
+  max_ns_.store( 0, std::memory_order_relaxed );
+}
+
+MetricsRegistry::MetricsRegistry() = default;
+
+LatencyHistogram &MetricsRegistry::stageLatency( const std::string &name )
+{
+  std::lock_guard lock( stages_mutex_ );
+  for ( const auto &histogram : stages_ ) {
+    if ( histogram->name() == name )
+      return *histogram;
+  }
+  stages_.push_back( std::make_unique<LatencyHistogram>( name ) );
+  return *stages_.back();
+}
+
+void MetricsRegistry::recordFrame( int frame_number, bool thermal,
+                                   std::chrono::steady_clock::time_point now ) noexcept
+{
+  if ( restart_frame_tracking_.exchange( false, std::memory_order_relaxed ) ) {
+    // An interval stored while reset() ran would survive it otherwise.
+    frame_interval_ns_.store( 0, std::memory_order_relaxed );
+    last_frame_number_ = -1;
+    last_frame_time_ = {};
+  }
+  frames_.fetch_add( 1, std::memory_order_relaxed );
+  if ( thermal )
+    thermal_frames_.fetch_add( 1, std::memory_order_relaxed );
+  if ( frame_number >= 0 && last_frame_number_ >= 0 ) {
+    // 16 bit wrapping counter.
+    const int gap = ( frame_number - last_frame_number_ ) & 0xFFFF;
+    if ( gap > 1 && gap <= kMaxFrameGap )
+      dropped_frames_.fetch_add( gap - 1, std::memory_order_relaxed );
+  }
+  last_frame_number_ = frame_number;
+  if ( last_frame_time_ != std::chrono::steady_clock::time_point{} ) {
+    const auto interval = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( now - last_frame_time_ ).count() );
+    const uint64_t smoothed = frame_interval_ns_.load( std::memory_order_relaxed );
+    frame_interval_ns_.store( smoothed == 0 ? interval
+                                            : smoothed - ( smoothed >> kIntervalSmoothingShift ) +
+                                                  ( interval >> kIntervalSmoothingShift ),
+                              std::memory_order_relaxed );
+  }
+  last_frame_time_ = now;
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const
+{
+  MetricsSnapshot result;
+  result.frames = frames_.load( std::memory_order_relaxed );
+  result.thermal_frames = thermal_frames_.load( std::memory_order_relaxed );
+  result.dropped_frames = dropped_frames_.load( std::memory_order_relaxed );
+  result.transfer_errors = transfer_errors_.load( std::memory_order_relaxed );
+  const uint64_t interval = frame_interval_ns_.load( std::memory_order_relaxed );
+  result.frame_rate = interval == 0 ? 0.0 : 1e9 / static_cast<double>( interval );
+  result.transfer = transfer_.snapshot();
+  result.processing = processing_.snapshot();
+  std::lock_guard lock( stages_mutex_ );
+  result.stages.reserve( stages_.size() );
+  for ( const auto &histogram : stages_ ) result.stages.push_back( histogram->snapshot() );
+  return result;
+}
+
+void MetricsRegistry::reset()
+{
+  transfer_.reset();
+  processing_.reset();
+  {
+    std::lock_guard lock( stages_mutex_ );
+    for ( const auto &histogram : stages_ ) histogram->reset();
+  }
+  frames_.store( 0, std::memory_order_relaxed );
+  thermal_frames_.store( 0, std::memory_order_relaxed );
+  dropped_frames_.store( 0, std::memory_order_relaxed );
+  transfer_errors_.store( 0, std::memory_order_relaxed );
+  frame_interval_ns_.store( 0, std::memory_order_relaxed );
+  restart_frame_tracking_.store( true, std::memory_order_relaxed );
+}
+
+void writePrometheusText( std::ostream &out, const MetricsSnapshot &snapshot,
+                          const std::string &camera )
+{
+  const std::string labels = "camera=\"" + escapeLabel( camera ) + "\"";
+  out << "# HELP openseekthermal_frames_total Transfers received from the camera.\n"
+      << "# TYPE openseekthermal_frames_total counter\n"
+      << "openseekthermal_frames_total{" << labels << "} " << snapshot.frames << "\n"
+      << "# HELP openseekthermal_thermal_frames_total Transfers that were thermal frames.\n"
+      << "# TYPE openseekthermal_thermal_frames_total counter\n"
+      << "openseekthermal_thermal_frames_total{" << labels << "} " << snapshot.thermal_frames
+      << "\n"
+      << "# HELP openseekthermal_dropped_frames_total Frames missing from the camera's counter.\n"
+      << "# TYPE openseekthermal_dropped_frames_total counter\n"
+      << "openseekthermal_dropped_frames_total{" << labels << "} " << snapshot.dropped_frames
+      << "\n"
+      << "# HELP openseekthermal_transfer_errors_total Failed or incomplete USB transfers.\n"
+      << "# TYPE openseekthermal_transfer_errors_total counter\n"
+      << "openseekthermal_transfer_errors_total{" << labels << "} " << snapshot.transfer_errors
+      << "\n"
+      << "# HELP openseekthermal_frame_rate_hertz Smoothed transfer rate.\n"
+      << "# TYPE openseekthermal_frame_rate_hertz gauge\n"
+      << "openseekthermal_frame_rate_hertz{" << labels << "} " << snapshot.frame_rate << "\n";
+
+  out << "# HELP openseekthermal_transfer_seconds Time to receive one transfer over USB.\n"
+      << "# TYPE openseekthermal_transfer_seconds summary\n";
+  writeSummary( out, "openseekthermal_transfer_seconds", snapshot.transfer, labels );
+  out << "# HELP openseekthermal_processing_seconds Host processing time of one grab.\n"
+      << "# TYPE openseekthermal_processing_seconds summary\n";
+  writeSummary( out, "openseekthermal_processing_seconds", snapshot.processing, labels );
+  out << "# HELP openseekthermal_stage_seconds Processing time of one stage per frame.\n"
+      << "# TYPE openseekthermal_stage_seconds summary\n";
+  for ( const LatencySnapshot &stage : snapshot.stages ) {
+    writeSummary( out, "openseekthermal_stage_seconds", stage,
+                  labels + ",stage=\"" + escapeLabel( stage.name ) + "\"" );
+  }
+
+  out << "# HELP openseekthermal_latency_max_seconds Longest observed latency.\n"
+      << "# TYPE openseekthermal_latency_max_seconds gauge\n";
+  out << "openseekthermal_latency_max_seconds{" << labels << ",metric=\"transfer\"} "
+      << snapshot.transfer.max_ms / 1e3 << "\n";
+  out << "openseekthermal_latency_max_seconds{" << labels << ",metric=\"processing\"} "
+      << snapshot.processing.max_ms / 1e3 << "\n";
+  for ( const LatencySnapshot &stage : snapshot.stages ) {
+    out << "openseekthermal_latency_max_seconds{" << labels << ",metric=\"stage\",stage=\""
+        << escapeLabel( stage.name ) << "\"} " << stage.max_ms / 1e3 << "\n";
+  }
+}
+
+void writePrometheusFile( const std::string &path, const MetricsSnapshot &snapshot,
+                          const std::string &camera )
+{
+  const std::string temporary = path + ".tmp";
+  {
+    std::ofstream file( temporary, std::ios::trunc );
+    if ( !file )
+      throw std::runtime_error( "Failed to open '" + temporary + "' for writing" );
+    writePrometheusText( file, snapshot, camera );
+    if ( !file.flush() )
+      throw std::runtime_error( "Failed to write '" + temporary + "'" );
+  }
+  if ( std::rename( temporary.c_str(), path.c_str() ) != 0 )
+    throw std::runtime_error( "Failed to rename '" + temporary + "' to '" + path + "'" );
+}
+
+} // namespace openseekthermal
@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/non_uniformity_correction.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+std::shared_ptr<const int32_t> quantize( const std::vector<double> &values, int32_t min,
+                                         int32_t max )
+{
+  auto table = std::make_shared<std::vector<int32_t>>( values.size() );
+  for ( size_t i = 0; i < values.size(); ++i ) {
+    const double q = std::round( values[i] * ( 1 << NonUniformityCorrection::kFractionBits ) );
+    ( *table )[i] = static_cast<int32_t>( std::clamp( q, double( min ), double( max ) ) );
+  }
+  return std::shared_ptr<const int32_t>( table, table->data() );
+}
+
+} // namespace
+
+NonUniformityCorrection::NonUniformityCorrection( int width, int height,
+                                                  const std::vector<double> &gain,
+                                                  const std::vector<double> &offset )
+    : width_( width ), height_( height )
+{
+  const size_t pixel_count = static_cast<size_t>( width ) * height;
+  if ( gain.size() != pixel_count || offset.size() != pixel_count ) {
+    throw std::invalid_argument(
+        "NonUniformityCorrection: table size does not match width*height" );
+  }
+  gain_ = quantize( gain, 0, kMaxGain - 1 );
+  offset_ = quantize( offset, -kMaxOffset, kMaxOffset );
+}
+
+NonUniformityCorrection::NonUniformityCorrection( int width, int height,
+                                                  std::shared_ptr<const int32_t> gain,
+                                                  std::shared_ptr<const int32_t> offset )
+    : width_( width ), height_( height ), gain_( std::move( gain ) ), offset_( std::move( offset ) )
+{
+}
+
+void NonUniformityCorrection::apply( uint16_t *frame ) const
+{
+  const size_t pixel_count = static_cast<size_t>( width_ ) * height_;
+  const int32_t *gain = gain_.get();
+  const int32_t *offset = offset_.get();
+  if ( gain == nullptr || offset == nullptr )
+    return;
+  constexpr int32_t round = 1 << ( kFractionBits - 1 );
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    const int32_t v = ( frame[i] * gain[i] + offset[i] + round ) >> kFractionBits;
+    frame[i] = static_cast<uint16_t>( std::clamp( v, 0, 0xFFFF ) );
+  }
+}
+
+} // namespace openseekthermal
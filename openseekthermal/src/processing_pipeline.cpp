@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/detail/processing_pipeline.hpp"
+#include "openseekthermal/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+//! Frame data per band when no band height is set; with the per-pixel tables
+//! of the built-in stages this keeps a band of every buffer within L2.
+constexpr size_t kTargetBandBytes = 16 * 1024;
+
+} // namespace
+
+ProcessingPipeline::ProcessingPipeline( FramePipeline &builtins, MetricsRegistry &metrics )
+    : builtins_( builtins ), stages_( builtins.builtinStages() ), metrics_( metrics )
+{
+}
+
+void ProcessingPipeline::insertStage( ProcessingStage::SharedPtr stage, const std::string &before )
+{
+  if ( stage == nullptr )
+    throw std::invalid_argument( "Processing stage must not be null" );
+  if ( std::find( stages_.begin(), stages_.end(), stage ) != stages_.end() )
+    throw std::invalid_argument( std::string( "Processing stage '" ) + stage->name() +
+                                 "' is already in the pipeline" );
+  auto it = stages_.end();
+  if ( !before.empty() ) {
+    it = std::find_if( stages_.begin(), stages_.end(),
+                       [&before]( const ProcessingStage::SharedPtr &s ) {
+                         return before == s->name();
+                       } );
+    if ( it == stages_.end() )
+      throw std::invalid_argument( "No processing stage named '" + before + "'" );
+  }
+  stages_.insert( it, std::move( stage ) );
+}
+
+bool ProcessingPipeline::removeStage( const ProcessingStage *stage )
+{
+  const auto &builtin = builtins_.builtinStages();
+  if ( std::any_of( builtin.begin(), builtin.end(),
+                    [stage]( const ProcessingStage::SharedPtr &s ) { return s.get() == stage; } ) )
+    throw std::invalid_argument( "Built-in processing stages cannot be removed" );
+  const auto it =
+      std::find_if( stages_.begin(), stages_.end(),
+                    [stage]( const ProcessingStage::SharedPtr &s ) { return s.get() == stage; } );
+  if ( it == stages_.end() )
+    return false;
+  stages_.erase( it );
+  return true;
+}
+
+void ProcessingPipeline::plan()
+{
+  plan_.clear();
+  size_t fused = 0;
+  unsigned pending = 0;
+  const auto flush = [&]() {
+    if ( pending == 0 )
+      return;
+    ProcessingStage *stage = builtins_.fusedPointStage( fused++, pending );
+    plan_.push_back( { stage, nullptr, nullptr, 0, 0, {}, nullptr, nullptr } );
+    pending = 0;
+  };
+  for ( const ProcessingStage::SharedPtr &stage : stages_ ) {
+    if ( !stage->enabled() )
+      continue;
+    if ( const unsigned point = builtins_.pointStages( stage.get() ); point != 0 ) {
+      pending |= point;
+      continue;
+    }
+    flush();
+    plan_.push_back( { stage.get(), nullptr, nullptr, stage->halo(), 0, {}, nullptr, nullptr } );
+  }
+  flush();
+}
+
+void ProcessingPipeline::run( const FrameHeader &header, const uint16_t *source, uint16_t *frame,
+                              FrameStatsAccumulator *stats, const BandCallback &on_band )
+{
+  const int width = builtins_.width();
+  const int height = builtins_.height();
+  const RegionOfInterest &region = builtins_.region();
+  const size_t pixel_count = static_cast<size_t>( width ) * height;
+  plan();
+
+  // Assign buffers: in place where allowed, otherwise alternate between the
+  // output frame and the scratch frame. The last step writes the output frame
+  // directly whenever it can, which saves the final copy.
+  const uint16_t *current = source;
+  for ( size_t i = 0; i < plan_.size(); ++i ) {
+    Step &step = plan_[i];
+    const bool writable = current != source || source == frame;
+    const bool last = i + 1 == plan_.size();
+    uint16_t *output;
+    if ( step.stage->inPlace() && writable && !( last && current != frame ) ) {
+      output = const_cast<uint16_t *>( current );
+    } else if ( current != frame ) {
+      output = frame;
+    } else {
+      scratch_.resize( pixel_count );
+      output = scratch_.data();
+    }
+    step.input = current;
+    step.output = output;
+    const StageMetrics &metrics = stageMetrics( step.stage->name() );
+    step.latency = metrics.latency;
+    step.trace_name = metrics.trace_name;
+    step.stage->beginFrame( header, width, height );
+    current = output;
+  }
+
+  // Bands of the result are handed on as the last step completes them. If it
+  // writes the scratch frame, its input is the output frame, whose rows it may
+  // still read as halo, so the copy and the callback wait for the whole frame.
+  const auto finishRows = [&]( const uint16_t *result, int row_begin, int row_end ) {
+    const size_t offset = static_cast<size_t>( row_begin ) * width;
+    if ( stats != nullptr )
+      stats->add( result + offset, static_cast<size_t>( row_end - row_begin ) * width );
+    if ( on_band && result == frame )
+      on_band( row_begin, row_end );
+  };
+
+  // Wavefront over row bands. A step may produce a row once its input rows up
+  // to its halo are complete, and only once its predecessor no longer reads
+  // the rows it overwrites (the predecessor's halo).
+  const int band =
+      band_rows_ > 0
+          ? band_rows_
+          : std::max( 1, static_cast<int>( kTargetBandBytes / ( sizeof( uint16_t ) * width ) ) );
+  for ( int end = std::min( band, height );; end = std::min( end + band, height ) ) {
+    int ready = end;
+    int previous_halo = 0;
+    for ( Step &step : plan_ ) {
+      const int limit =
+          ready >= height ? height : std::max( 0, ready - std::max( step.halo, previous_halo ) );
+      if ( limit > step.done ) {
+        const auto start = std::chrono::steady_clock::now();
+        step.stage->process(
+            { step.input, step.output, width, height, step.done, limit, region.x, region.y } );
+        const auto end = std::chrono::steady_clock::now();
+        OPENSEEKTHERMAL_TRACE_COMPLETE( step.trace_name, start, end );
+        step.time += end - start;
+        if ( &step == &plan_.back() )
+          finishRows( step.output, step.done, limit );
+        step.done = limit;
+      }
+      ready = step.done;
+      previous_halo = step.halo;
+    }
+    if ( end >= height )
+      break;
+  }
+  if ( plan_.empty() )
+    finishRows( source, 0, height );
+  if ( current != frame ) {
+    std::memcpy( frame, current, pixel_count * sizeof( uint16_t ) );
+    if ( on_band )
+      on_band( 0, height );
+  }
+
+  for ( const Step &step : plan_ ) step.latency->record( step.time );
+}
+
+const ProcessingPipeline::StageMetrics &ProcessingPipeline::stageMetrics( const char *name )
+{
+  for ( const StageMetrics &metrics : stage_metrics_ ) {
+    if ( metrics.name == name )
+      return metrics;
+  }
+  stage_metrics_.push_back( { name, &metrics_.stageLatency( name ),
+                              isTracingEnabled() ? internTraceName( name ) : nullptr } );
+  return stage_metrics_.back();
+}
+
+} // namespace openseekthermal
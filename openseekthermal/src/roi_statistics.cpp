@@ -0,0 +1,194 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/roi_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+int floorLog2( int value ) { return 31 - __builtin_clz( static_cast<unsigned>( value ) ); }
+
+//! Row of integral image `row` from the frame row `pixels` and the integral
+//! row above. The prefix is a serial dependency chain; adding the row above
+//! is not and is left to a separate, vectorizable loop.
+void integralRow( const uint16_t *__restrict__ pixels, const uint64_t *__restrict__ sum_above,
+                  const uint64_t *__restrict__ squares_above, uint64_t *__restrict__ sum_row,
+                  uint64_t *__restrict__ squares_row, int width )
+{
+  uint64_t sum = 0;
+  uint64_t squares = 0;
+  for ( int x = 0; x < width; ++x ) {
+    const uint64_t value = pixels[x];
+    sum += value;
+    squares += value * value;
+    sum_row[x] = sum;
+    squares_row[x] = squares;
+  }
+  for ( int x = 0; x < width; ++x ) {
+    sum_row[x] += sum_above[x];
+    squares_row[x] += squares_above[x];
+  }
+}
+
+//! Row of a pyramid level from the rows `top` and `bottom` = `top` + `step`
+//! rows of the level below.
+template<typename Op>
+void pyramidRow( const uint16_t *__restrict__ top, const uint16_t *__restrict__ bottom,
+                 uint16_t *__restrict__ out, int step, int columns, Op op )
+{
+  for ( int x = 0; x < columns; ++x )
+    out[x] = op( op( top[x], top[x + step] ), op( bottom[x], bottom[x + step] ) );
+}
+
+} // namespace
+
+RoiAnalyzer::RoiAnalyzer( int pyramid_levels )
+    : pyramid_levels_( std::clamp( pyramid_levels, 0, kMaxPyramidLevels ) )
+{
+}
+
+void RoiAnalyzer::update( const uint16_t *frame, int width, int height )
+{
+  addRows( frame, width, height, 0, height );
+}
+
+void RoiAnalyzer::addRows( const uint16_t *frame, int width, int height, int row_begin,
+                           int row_end )
+{
+  if ( row_begin == 0 ) {
+    if ( width != width_ || height != height_ ) {
+      width_ = width;
+      height_ = height;
+      const size_t integral_size = static_cast<size_t>( width + 1 ) * ( height + 1 );
+      sum_.assign( integral_size, 0 );
+      sum_squares_.assign( integral_size, 0 );
+      const int levels =
+          width > 0 && height > 0
+              ? std::min( pyramid_levels_, floorLog2( std::min( width, height ) ) ) + 1
+              : 0;
+      min_levels_.assign( levels, std::vector<uint16_t>( static_cast<size_t>( width ) * height ) );
+      max_levels_.assign( levels, std::vector<uint16_t>( static_cast<size_t>( width ) * height ) );
+    }
+    frame_origin_x_ = origin_x_;
+    frame_origin_y_ = origin_y_;
+    rows_ = 0;
+    complete_ = false;
+  }
+  if ( row_begin != rows_ || width != width_ || height != height_ || row_end > height ||
+       row_end <= row_begin )
+    return;
+
+  for ( int y = row_begin; y < row_end; ++y ) {
+    integralRow( frame + static_cast<size_t>( y ) * width, sum_.data() + integralIndex( 1, y ),
+                 sum_squares_.data() + integralIndex( 1, y ),
+                 sum_.data() + integralIndex( 1, y + 1 ),
+                 sum_squares_.data() + integralIndex( 1, y + 1 ), width );
+  }
+  const size_t offset = static_cast<size_t>( row_begin ) * width;
+  const size_t count = static_cast<size_t>( row_end - row_begin ) * width;
+  if ( !min_levels_.empty() ) {
+    std::memcpy( min_levels_[0].data() + offset, frame + offset, count * sizeof( uint16_t ) );
+    std::memcpy( max_levels_[0].data() + offset, frame + offset, count * sizeof( uint16_t ) );
+  }
+  rows_ = row_end;
+  if ( rows_ == height_ ) {
+    buildPyramid();
+    complete_ = true;
+  }
+}
+
+void RoiAnalyzer::buildPyramid()
+{
+  const int width = width_;
+  for ( size_t level = 1; level < min_levels_.size(); ++level ) {
+    const int step = 1 << ( level - 1 );
+    const int size = 1 << level;
+    const int columns = width - size + 1;
+    const int rows = height_ - size + 1;
+    const uint16_t *min_in = min_levels_[level - 1].data();
+    const uint16_t *max_in = max_levels_[level - 1].data();
+    for ( int y = 0; y < rows; ++y ) {
+      const size_t top = static_cast<size_t>( y ) * width;
+      const size_t bottom = top + static_cast<size_t>( step ) * width;
+      pyramidRow( min_in + top, min_in + bottom, min_levels_[level].data() + top, step, columns,
+                  []( uint16_t a, uint16_t b ) { return std::min( a, b ); } );
+      pyramidRow( max_in + top, max_in + bottom, max_levels_[level].data() + top, step, columns,
+                  []( uint16_t a, uint16_t b ) { return std::max( a, b ); } );
+    }
+  }
+}
+
+RoiStatistics RoiAnalyzer::query( const RegionOfInterest &roi ) const noexcept
+{
+  RoiStatistics result;
+  if ( !complete_ )
+    return result;
+  const int x = roi.x - frame_origin_x_;
+  const int y = roi.y - frame_origin_y_;
+  const int x0 = std::max( x, 0 );
+  const int y0 = std::max( y, 0 );
+  const int x1 = std::min( x + roi.width, width_ );
+  const int y1 = std::min( y + roi.height, height_ );
+  if ( x1 <= x0 || y1 <= y0 )
+    return result;
+
+  const auto rectangle = [&]( const std::vector<uint64_t> &integral ) {
+    return integral[integralIndex( x1, y1 )] - integral[integralIndex( x0, y1 )] -
+           integral[integralIndex( x1, y0 )] + integral[integralIndex( x0, y0 )];
+  };
+  const auto count = static_cast<size_t>( x1 - x0 ) * ( y1 - y0 );
+  const double n = static_cast<double>( count );
+  result.pixel_count = count;
+  result.mean = static_cast<double>( rectangle( sum_ ) ) / n;
+  const double variance =
+      static_cast<double>( rectangle( sum_squares_ ) ) / n - result.mean * result.mean;
+  result.stddev = variance > 0.0 ? std::sqrt( variance ) : 0.0;
+
+  // Cover the rectangle with overlapping blocks of the largest level that fits.
+  const int level = std::min( static_cast<int>( min_levels_.size() ) - 1,
+                              floorLog2( std::min( x1 - x0, y1 - y0 ) ) );
+  const int size = 1 << level;
+  const uint16_t *min_level = min_levels_[level].data();
+  const uint16_t *max_level = max_levels_[level].data();
+  uint16_t min = 0xFFFF;
+  uint16_t max = 0;
+  for ( int y = y0;; y += size ) {
+    const int block_y = std::min( y, y1 - size );
+    const uint16_t *min_row = min_level + static_cast<size_t>( block_y ) * width_;
+    const uint16_t *max_row = max_level + static_cast<size_t>( block_y ) * width_;
+    for ( int x = x0;; x += size ) {
+      const int block_x = std::min( x, x1 - size );
+      min = std::min( min, min_row[block_x] );
+      max = std::max( max, max_row[block_x] );
+      if ( block_x == x1 - size )
+        break;
+    }
+    if ( block_y == y1 - size )
+      break;
+  }
+  result.min = min;
+  result.max = max;
+  return result;
+}
+
+RoiStatistics RoiAnalyzer::frameStatistics() const noexcept
+{
+  return query( { frame_origin_x_, frame_origin_y_, width_, height_ } );
+}
+
+void RoiStatisticsStage::process( const StageRows &rows )
+{
+  passThroughRows( rows );
+  if ( rows.row_begin == 0 )
+    analyzer_.setOrigin( rows.origin_x, rows.origin_y );
+  analyzer_.addRows( rows.output, rows.width, rows.height, rows.row_begin, rows.row_end );
+}
+
+} // namespace openseekthermal
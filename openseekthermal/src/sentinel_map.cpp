@@ -0,0 +1,239 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/detail/sentinel_map.hpp"
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+constexpr uint8_t kKnown = 1;
+constexpr uint8_t kCalibrated = 2;
+
+// 3x3 gaussian weights of the eight neighbours in the same row-major order as
+// neighbor_offsets_ (centre skipped; it is the pixel being inpainted).
+constexpr int kNeighborWeights[8] = { 1, 2, 1, 2, 2, 1, 2, 1 };
+
+inline bool isSentinel( uint16_t v ) { return v == 0 || v == 0xFFFF; }
+
+inline uint16_t applyColumnOffset( uint16_t v, const int32_t *column_offset, int x )
+{
+  if ( column_offset == nullptr )
+    return v;
+  const int32_t corrected = static_cast<int32_t>( v ) - column_offset[x];
+  return static_cast<uint16_t>( std::clamp( corrected, 0, 0xFFFF ) );
+}
+
+} // namespace
+
+void SentinelMap::reset( int width, int height, int row_step )
+{
+  width_ = width;
+  height_ = height;
+  row_step_ = row_step;
+  int k = 0;
+  for ( int dy = -1; dy <= 1; ++dy ) {
+    for ( int dx = -1; dx <= 1; ++dx ) {
+      if ( dy == 0 && dx == 0 )
+        continue;
+      neighbor_offsets_[k++] = dy * row_step + dx;
+    }
+  }
+  const size_t pixel_count = static_cast<size_t>( width ) * height;
+  score_.assign( pixel_count, 0 );
+  flags_.assign( pixel_count, 0 );
+  index_.clear();
+  raw_index_.clear();
+  neighbor_mask_.clear();
+  frames_since_decay_ = 0;
+  fallback_scans_ = 0;
+  dirty_ = false;
+}
+
+void SentinelMap::setCalibratedDeadPixels( const DeadPixelMask *mask )
+{
+  for ( uint8_t &f : flags_ ) f &= static_cast<uint8_t>( ~kCalibrated );
+  if ( mask != nullptr && mask->width() == width_ && mask->height() == height_ ) {
+    for ( const DeadPixelEntry &entry : mask->entries() ) flags_[entry.index] |= kCalibrated;
+  }
+  rebuild();
+}
+
+uint8_t SentinelMap::neighborMask( int x, int y ) const
+{
+  uint8_t mask = 0;
+  int k = 0;
+  for ( int dy = -1; dy <= 1; ++dy ) {
+    for ( int dx = -1; dx <= 1; ++dx ) {
+      if ( dy == 0 && dx == 0 )
+        continue;
+      const int ny = y + dy;
+      const int nx = x + dx;
+      if ( ny >= 0 && ny < height_ && nx >= 0 && nx < width_ )
+        mask |= static_cast<uint8_t>( 1u << k );
+      ++k;
+    }
+  }
+  return mask;
+}
+
+uint16_t SentinelMap::inpaint( const uint16_t *data, uint32_t raw_index,
+                               uint8_t neighbor_mask ) const
+{
+  int sum = 0;
+  int count = 0;
+  for ( int k = 0; k < 8; ++k ) {
+    if ( ( neighbor_mask & ( 1u << k ) ) == 0 )
+      continue;
+    const uint16_t value = le16toh( data[static_cast<int>( raw_index ) + neighbor_offsets_[k]] );
+    if ( isSentinel( value ) )
+      continue;
+    sum += value * kNeighborWeights[k];
+    count += kNeighborWeights[k];
+  }
+  return count == 0 ? 0 : static_cast<uint16_t>( sum / count );
+}
+
+void SentinelMap::fixKnown( const uint16_t *data, uint16_t *frame, size_t sentinels, bool learn,
+                            const int32_t *column_offset )
+{
+  // Fix the known positions. A known pixel that reads a valid value this frame
+  // is passed through untouched.
+  size_t known_hits = 0;
+  for ( size_t k = 0; k < index_.size(); ++k ) {
+    const uint32_t i = index_[k];
+    uint8_t &score = score_[i];
+    if ( isSentinel( le16toh( data[raw_index_[k]] ) ) ) {
+      frame[i] = applyColumnOffset( inpaint( data, raw_index_[k], neighbor_mask_[k] ),
+                                    column_offset, static_cast<int>( i % width_ ) );
+      ++known_hits;
+      if ( learn )
+        score = score > 255 - kHitGain ? 255 : score + kHitGain;
+    } else if ( learn && score > 0 && --score == 0 && ( flags_[i] & kCalibrated ) == 0 ) {
+      dirty_ = true;
+    }
+  }
+
+  if ( sentinels > known_hits ) {
+    scanAndLearn( data, frame, learn, column_offset );
+  }
+  if ( learn && ++frames_since_decay_ >= kDecayInterval ) {
+    decayCandidates();
+  }
+  if ( dirty_ ) {
+    rebuild();
+  }
+}
+
+size_t SentinelMap::extractRegion( const uint16_t *data, uint16_t *frame, int region_x,
+                                  int region_y, int region_width, int region_height,
+                                  const int32_t *column_offset )
+{
+  const int region_end_x = region_x + region_width;
+  const int region_end_y = region_y + region_height;
+  assert( region_x >= 0 && region_y >= 0 && region_end_x <= width_ && region_end_y <= height_ );
+  size_t sentinels = 0;
+  for ( int y = region_y; y < region_end_y; ++y ) {
+    const uint16_t *__restrict__ row_in = data + static_cast<size_t>( y ) * row_step_;
+    uint16_t *__restrict__ row_out = frame + static_cast<size_t>( y - region_y ) * region_width;
+    for ( int x = region_x; x < region_end_x; ++x ) {
+      const uint16_t v = le16toh( row_in[x] );
+      row_out[x - region_x] = applyColumnOffset( v, column_offset, x );
+      sentinels += static_cast<size_t>( isSentinel( v ) );
+    }
+  }
+  if ( sentinels == 0 )
+    return 0;
+
+  // The known list is sorted row-major; visit the entries of the region's rows.
+  size_t known_hits = 0;
+  const auto first = std::lower_bound( index_.begin(), index_.end(),
+                                       static_cast<uint32_t>( region_y * width_ ) );
+  for ( size_t k = first - index_.begin(); k < index_.size(); ++k ) {
+    const int y = static_cast<int>( index_[k] / width_ );
+    const int x = static_cast<int>( index_[k] % width_ );
+    if ( y >= region_end_y )
+      break;
+    if ( x < region_x || x >= region_end_x || !isSentinel( le16toh( data[raw_index_[k]] ) ) )
+      continue;
+    frame[static_cast<size_t>( y - region_y ) * region_width + ( x - region_x )] =
+        applyColumnOffset( inpaint( data, raw_index_[k], neighbor_mask_[k] ), column_offset, x );
+    ++known_hits;
+  }
+  if ( sentinels == known_hits )
+    return sentinels;
+  for ( int y = region_y; y < region_end_y; ++y ) {
+    for ( int x = region_x; x < region_end_x; ++x ) {
+      const uint32_t raw_index = static_cast<uint32_t>( y * row_step_ + x );
+      if ( !isSentinel( le16toh( data[raw_index] ) ) ||
+           ( flags_[static_cast<size_t>( y ) * width_ + x] & kKnown ) )
+        continue;
+      frame[static_cast<size_t>( y - region_y ) * region_width + ( x - region_x )] =
+          applyColumnOffset( inpaint( data, raw_index, neighborMask( x, y ) ), column_offset, x );
+    }
+  }
+  return sentinels;
+}
+
+void SentinelMap::scanAndLearn( const uint16_t *data, uint16_t *frame, bool learn,
+                                const int32_t *column_offset )
+{
+  ++fallback_scans_;
+  for ( int y = 0; y < height_; ++y ) {
+    for ( int x = 0; x < width_; ++x ) {
+      const uint32_t raw_index = static_cast<uint32_t>( y * row_step_ + x );
+      if ( !isSentinel( le16toh( data[raw_index] ) ) )
+        continue;
+      const size_t i = static_cast<size_t>( y ) * width_ + x;
+      if ( flags_[i] & kKnown )
+        continue;
+      frame[i] = applyColumnOffset( inpaint( data, raw_index, neighborMask( x, y ) ),
+                                    column_offset, x );
+      if ( !learn )
+        continue;
+      const uint8_t score = score_[i] > 255 - kHitGain ? 255 : score_[i] + kHitGain;
+      score_[i] = score;
+      if ( score >= kPromoteScore )
+        dirty_ = true;
+    }
+  }
+}
+
+void SentinelMap::decayCandidates()
+{
+  frames_since_decay_ = 0;
+  const size_t pixel_count = score_.size();
+  uint8_t *__restrict__ score = score_.data();
+  const uint8_t *__restrict__ flags = flags_.data();
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    score[i] = ( flags[i] & kKnown ) ? score[i] : static_cast<uint8_t>( score[i] >> 1 );
+  }
+}
+
+void SentinelMap::rebuild()
+{
+  dirty_ = false;
+  index_.clear();
+  raw_index_.clear();
+  neighbor_mask_.clear();
+  for ( int y = 0; y < height_; ++y ) {
+    for ( int x = 0; x < width_; ++x ) {
+      const size_t i = static_cast<size_t>( y ) * width_ + x;
+      const bool known = ( flags_[i] & kKnown ) != 0;
+      const bool keep = ( flags_[i] & kCalibrated ) != 0 || ( known && score_[i] > 0 ) ||
+                        ( !known && score_[i] >= kPromoteScore );
+      if ( !keep ) {
+        flags_[i] &= static_cast<uint8_t>( ~kKnown );
+        continue;
+      }
+      flags_[i] |= kKnown;
+      index_.push_back( static_cast<uint32_t>( i ) );
+      raw_index_.push_back( static_cast<uint32_t>( y * row_step_ + x ) );
+      neighbor_mask_.push_back( neighborMask( x, y ) );
+    }
+  }
+}
+
+} // namespace openseekthermal
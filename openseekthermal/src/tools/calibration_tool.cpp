@@ -2,7 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 // Interactive, menu-driven CLI that walks through the full per-unit calibration
-// (vignette, dead pixels, temperature) and writes a unified calibration .ini via
+// (vignette, dead pixels, temperature, non-uniformity) and writes a unified calibration .ini via
 // saveCameraCalibration(). An existing .ini can be loaded to update; every
 // section is independently skippable.
 //
@@ -21,6 +21,7 @@
 
 #include "common/capture_helpers.hpp"
 #include "common/detect_dead_pixels.hpp"
+#include "common/fit_non_uniformity.hpp"
 #include "common/fit_vignette.hpp"
 #include "common/terminal_preview.hpp"
 #include "openseekthermal/camera_calibration.hpp"
@@ -314,7 +315,7 @@ void doKnownTemperature( SeekThermalCamera &cam, CameraCalibration &cal, int wid
   std::string err;
   // Seed {c1, c0_start} from the calibration the camera currently maps with, so
   // the provisional reading matches what the camera reports live.
-  const TemperatureCalibration seed = *cam.calibration().temperature;
+  const TemperatureCalibration seed = *cam.calibration()->temperature;
   const double c1 = seed.c1;
   const double c0_start = seed.c0;
 
@@ -440,7 +441,7 @@ void doManualOffset( SeekThermalCamera &cam, CameraCalibration &cal, bool &dirty
 
   // Seed from the calibration the camera currently maps with (the installed cal
   // if any, otherwise the factory default derived at open()).
-  const TemperatureCalibration seed = *cam.calibration().temperature;
+  const TemperatureCalibration seed = *cam.calibration()->temperature;
   const double c1 = seed.c1;
   const double c0_start = seed.c0;
 
@@ -496,7 +497,109 @@ void doTemperature( SeekThermalCamera &cam, CameraCalibration &cal, int width, i
 }
 
 // ---------------------------------------------------------------------------
-// [4] Show current state
+// [4] Non-uniformity (per-pixel gain / offset)
+
+void doNonUniformity( SeekThermalCamera &cam, CameraCalibration &cal, int width, int height,
+                      bool &dirty )
+{
+  constexpr int kFrames = 100;
+  constexpr int kWarmup = 30;
+  constexpr double kMinSpan = 50.0;
+  constexpr double kMaxGain = 2.0;
+
+  const size_t pixel_count = static_cast<size_t>( width ) * height;
+  std::cout << "\n--- Non-uniformity calibration ---\n"
+            << "Needs two uniform scenes at clearly different temperatures that fill the\n"
+            << "whole field of view, e.g. a wall and then a warm plate or a pot lid held\n"
+            << "close to the lens. Run the vignette calibration first; it is applied\n"
+            << "before this correction.\n";
+
+  std::vector<bool> dead_mask;
+  if ( cal.dead_pixels ) {
+    dead_mask.assign( pixel_count, false );
+    for ( const auto &e : cal.dead_pixels->entries() ) dead_mask[e.index] = true;
+  }
+
+  // Capture in the count domain the correction operates in: after flat-field,
+  // dead-pixel and vignette correction, without a previously-installed
+  // non-uniformity correction and without the substrate-drift compensation
+  // (which runs after it and would shift the second scene). Both, plus the
+  // original `cal`, are restored on every exit path below.
+  CameraCalibration capture_cal = cal;
+  capture_cal.non_uniformity.reset();
+  const bool drift_was_enabled = cam.isDriftCompensationEnabled();
+  try {
+    cam.setCalibration( capture_cal );
+  } catch ( const std::exception &e ) {
+    std::cout << "Failed to prepare capture calibration: " << e.what() << "\n";
+    return;
+  }
+  cam.setDriftCompensationEnabled( false );
+  const auto restore_calibration = [&]() {
+    cam.setDriftCompensationEnabled( drift_was_enabled );
+    try {
+      cam.setCalibration( cal );
+    } catch ( const std::exception & ) {
+    }
+  };
+
+  const bool preview = isInteractiveTerminal();
+  const auto capture = [&]( const char *prompt, const char *label, std::vector<double> &avg ) {
+    if ( !livePreviewUntilStart( cam, std::cin, std::cout, prompt ) )
+      return false;
+    std::string err;
+    if ( !warmup( cam, kWarmup, err ) ) {
+      std::cout << err << "\n";
+      return false;
+    }
+    std::vector<uint64_t> sum;
+    int skipped_cal = 0;
+    if ( !accumulateAverage( cam, width, height, kFrames, sum, skipped_cal, label, &std::cout,
+                             preview, err ) ) {
+      std::cout << err << "\n";
+      return false;
+    }
+    avg.resize( pixel_count );
+    for ( size_t i = 0; i < pixel_count; ++i )
+      avg[i] = static_cast<double>( sum[i] ) / static_cast<double>( kFrames );
+    return true;
+  };
+  std::vector<double> cool, warm;
+  if ( !capture( "Aim at the COOL uniform scene (e.g. a wall).", "Capturing cool scene", cool ) ||
+       !capture( "Aim at the WARM uniform scene (fill the whole view).", "Capturing warm scene",
+                 warm ) ) {
+    restore_calibration();
+    return;
+  }
+
+  const NonUniformityFit fit = fitNonUniformity( cool, warm, width, height, kMinSpan, kMaxGain,
+                                                 dead_mask.empty() ? nullptr : &dead_mask );
+  if ( fit.gain.empty() ) {
+    std::cout << "The two scenes are less than " << kMinSpan
+              << " counts apart — use a larger temperature difference. Non-uniformity left\n"
+                 "unchanged.\n";
+    restore_calibration();
+    return;
+  }
+
+  std::cout << std::fixed << std::setprecision( 1 ) << "Scene means: cool=" << fit.mean_cool
+            << "  warm=" << fit.mean_warm << " counts\n"
+            << std::setprecision( 4 ) << "  gain range=[" << fit.min_gain << ", " << fit.max_gain
+            << "]  gain stddev=" << fit.gain_stddev << "\n"
+            << "  " << fit.unresponsive << " pixels left uncorrected (unresponsive)\n"
+            << std::defaultfloat;
+  if ( fit.unresponsive > pixel_count / 100 )
+    std::cout << "Note: many pixels did not follow the scene — the scenes may not have been\n"
+                 "      uniform or may not have filled the view.\n";
+
+  cal.non_uniformity = toNonUniformityCorrection( fit );
+  dirty = true;
+  restore_calibration();
+  std::cout << "Non-uniformity correction updated.\n";
+}
+
+// ---------------------------------------------------------------------------
+// [5] Show current state
 
 void showState( const CameraCalibration &cal, const SeekDevice &device, int width, int height )
 {
@@ -533,10 +636,27 @@ void showState( const CameraCalibration &cal, const SeekDevice &device, int widt
   } else {
     std::cout << "not set — omitted on save\n";
   }
+
+  std::cout << "[non_uniformity] ";
+  if ( cal.non_uniformity ) {
+    const NonUniformityCorrection &nuc = *cal.non_uniformity;
+    const size_t total = static_cast<size_t>( nuc.width() ) * nuc.height();
+    double min_gain = total > 0 ? nuc.gain( 0 ) : 1.0;
+    double max_gain = min_gain;
+    for ( size_t i = 1; i < total; ++i ) {
+      min_gain = std::min( min_gain, nuc.gain( i ) );
+      max_gain = std::max( max_gain, nuc.gain( i ) );
+    }
+    std::cout << nuc.width() << "x" << nuc.height() << "  gain range=[" << std::fixed
+              << std::setprecision( 4 ) << min_gain << ", " << max_gain << "]\n"
+              << std::defaultfloat;
+  } else {
+    std::cout << "not set — omitted on save\n";
+  }
 }
 
 // ---------------------------------------------------------------------------
-// [5] Save
+// [6] Save
 
 void doSave( const CameraCalibration &cal, const SeekDevice &device, fs::path &save_path,
              const std::string &default_name, int width, int height, bool &dirty )
@@ -556,6 +676,8 @@ void doSave( const CameraCalibration &cal, const SeekDevice &device, fs::path &s
     hdr << " vignette";
   if ( cal.dead_pixels )
     hdr << " dead_pixels";
+  if ( cal.non_uniformity )
+    hdr << " non_uniformity";
 
   try {
     saveCameraCalibration( path, cal, hdr.str() );
@@ -691,8 +813,10 @@ int main( int argc, char **argv )
                                    : "not set" )
               << ")\n"
               << "  [3] Calibrate temperature   (" << ( cal.temperature ? "set" : "not set" ) << ")\n"
-              << "  [4] Show current state\n"
-              << "  [5] Save calibration" << ( dirty ? "  (unsaved changes)" : "" ) << "\n"
+              << "  [4] Calibrate non-uniformity ("
+              << ( cal.non_uniformity ? "set" : "not set" ) << ")\n"
+              << "  [5] Show current state\n"
+              << "  [6] Save calibration" << ( dirty ? "  (unsaved changes)" : "" ) << "\n"
               << "  [q] Quit\n";
     const std::string choice = promptLine( std::cin, std::cout, "Select", "" );
     if ( !std::cin ) { // EOF / closed stdin — stop rather than spin
@@ -712,9 +836,12 @@ int main( int argc, char **argv )
       doTemperature( *camera, cal, width, height, dirty );
       break;
     case '4':
-      showState( cal, device, width, height );
+      doNonUniformity( *camera, cal, width, height, dirty );
       break;
     case '5':
+      showState( cal, device, width, height );
+      break;
+    case '6':
       doSave( cal, device, save_path, default_calibration_name, width, height, dirty );
       break;
     case 'q':
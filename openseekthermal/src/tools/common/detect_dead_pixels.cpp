@@ -3,6 +3,8 @@
 
 #include "detect_dead_pixels.hpp"
 
+#include "parallel_rows.hpp"
+
 #include <algorithm>
 
 namespace openseekthermal::tools
@@ -36,6 +38,43 @@ double medianOf( std::vector<double> &v )
   std::nth_element( v.begin(), v.begin() + mid, v.end() );
   return v[mid];
 }
+
+//! Multiset of ranks in [0, size) as a Fenwick tree of counts: insert, erase
+//! and selecting the k-th smallest element are O(log size).
+class RankCounter
+{
+public:
+  explicit RankCounter( int size ) : tree_( size + 1, 0 )
+  {
+    top_bit_ = 1;
+    while ( top_bit_ * 2 <= size ) top_bit_ *= 2;
+  }
+
+  void add( int rank, int delta )
+  {
+    for ( int i = rank + 1; i < static_cast<int>( tree_.size() ); i += i & -i ) tree_[i] += delta;
+  }
+
+  //! The rank with k smaller ones (0-based) in the multiset.
+  int select( int k ) const
+  {
+    int pos = 0;
+    for ( int bit = top_bit_; bit > 0; bit >>= 1 ) {
+      if ( pos + bit < static_cast<int>( tree_.size() ) && tree_[pos + bit] <= k ) {
+        pos += bit;
+        k -= tree_[pos];
+      }
+    }
+    return pos;
+  }
+
+private:
+  std::vector<int> tree_;
+  int top_bit_;
+};
+
+//! Rows per band of forEachRowBand().
+constexpr int kBandRows = 8;
 } // namespace
 
 DeadPixelResult detectDeadPixels( const RawPixelStats &stats, int width, int height )
@@ -56,34 +95,63 @@ DeadPixelResult detectDeadPixels( const RawPixelStats &stats, int width, int hei
       usable[i] = 1;
   }
 
-  // Local median stddev over each pixel's neighbourhood (usable neighbours only).
+  // Local median stddev over each pixel's neighbourhood (usable neighbours
+  // only). The usable stddevs are replaced by their ranks in sorted order, so
+  // the window becomes a multiset of ranks whose median is found by counting.
+  // The window slides along each row, adding the column entering it and
+  // removing the one leaving it, and the rows are processed in parallel bands.
+  std::vector<size_t> by_value;
+  by_value.reserve( pixel_count );
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    if ( usable[i] )
+      by_value.push_back( i );
+  }
+  std::sort( by_value.begin(), by_value.end(),
+             [&stats]( size_t a, size_t b ) { return stats.stddev[a] < stats.stddev[b]; } );
+  std::vector<int> rank( pixel_count, -1 );
+  for ( size_t k = 0; k < by_value.size(); ++k ) rank[by_value[k]] = static_cast<int>( k );
+
   std::vector<double> local_med( pixel_count, 0.0 );
-  std::vector<double> window;
-  window.reserve( ( 2 * kLocalRadius + 1 ) * ( 2 * kLocalRadius + 1 ) );
-  std::vector<double> activity_samples;
-  activity_samples.reserve( pixel_count );
-  for ( int y = 0; y < height; ++y ) {
-    const int y0 = std::max( 0, y - kLocalRadius );
-    const int y1 = std::min( height - 1, y + kLocalRadius );
-    for ( int x = 0; x < width; ++x ) {
-      const size_t i = static_cast<size_t>( y ) * width + x;
-      if ( !usable[i] )
-        continue;
-      const int x0 = std::max( 0, x - kLocalRadius );
-      const int x1 = std::min( width - 1, x + kLocalRadius );
-      window.clear();
+  std::vector<uint8_t> has_local( pixel_count, 0 );
+  const int rank_count = static_cast<int>( by_value.size() );
+  forEachRowBand( height, kBandRows, [&]( int, int begin, int end ) {
+    RankCounter window( rank_count );
+    int count = 0;
+    // Add (delta 1) or remove (delta -1) the usable pixels of column x in
+    // rows [y0, y1].
+    const auto column = [&]( int x, int y0, int y1, int delta ) {
       for ( int yy = y0; yy <= y1; ++yy ) {
-        for ( int xx = x0; xx <= x1; ++xx ) {
-          const size_t j = static_cast<size_t>( yy ) * width + xx;
-          if ( usable[j] )
-            window.push_back( stats.stddev[j] );
+        const int k = rank[static_cast<size_t>( yy ) * width + x];
+        if ( k >= 0 ) {
+          window.add( k, delta );
+          count += delta;
         }
       }
-      if ( static_cast<int>( window.size() ) < kMinLocalNeighbours )
-        continue;
-      local_med[i] = medianOf( window );
-      activity_samples.push_back( local_med[i] );
+    };
+    for ( int y = begin; y < end; ++y ) {
+      const int y0 = std::max( 0, y - kLocalRadius );
+      const int y1 = std::min( height - 1, y + kLocalRadius );
+      for ( int x = 0; x < std::min( width, kLocalRadius ); ++x ) column( x, y0, y1, 1 );
+      for ( int x = 0; x < width; ++x ) {
+        if ( x + kLocalRadius < width )
+          column( x + kLocalRadius, y0, y1, 1 );
+        if ( x - kLocalRadius - 1 >= 0 )
+          column( x - kLocalRadius - 1, y0, y1, -1 );
+        const size_t i = static_cast<size_t>( y ) * width + x;
+        if ( !usable[i] || count < kMinLocalNeighbours )
+          continue;
+        local_med[i] = stats.stddev[by_value[window.select( count / 2 )]];
+        has_local[i] = 1;
+      }
+      for ( int x = std::max( 0, width - kLocalRadius - 1 ); x < width; ++x )
+        column( x, y0, y1, -1 );
     }
+  } );
+  std::vector<double> activity_samples;
+  activity_samples.reserve( pixel_count );
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    if ( has_local[i] )
+      activity_samples.push_back( local_med[i] );
   }
   r.panning_activity = medianOf( activity_samples );
 
@@ -55,6 +55,8 @@ struct DeadPixelResult {
 };
 
 //! Flag dead pixels from accumulated raw statistics. No tunable parameters.
+//! The local medians are kept up to date as the neighbourhood slides along
+//! each row, and the rows are processed on all cores.
 DeadPixelResult detectDeadPixels( const RawPixelStats &stats, int width, int height );
 
 } // namespace openseekthermal::tools
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "fit_non_uniformity.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace openseekthermal::tools
+{
+
+NonUniformityFit fitNonUniformity( const std::vector<double> &cool, const std::vector<double> &warm,
+                                   int width, int height, double min_span, double max_gain,
+                                   const std::vector<bool> *dead_mask )
+{
+  NonUniformityFit fit;
+  fit.width = width;
+  fit.height = height;
+  const size_t pixel_count = static_cast<size_t>( width ) * height;
+  const auto isDead = [dead_mask]( size_t i ) { return dead_mask != nullptr && ( *dead_mask )[i]; };
+
+  double sum_cool = 0.0, sum_warm = 0.0;
+  size_t live = 0;
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    if ( isDead( i ) )
+      continue;
+    sum_cool += cool[i];
+    sum_warm += warm[i];
+    ++live;
+  }
+  if ( live == 0 )
+    return fit;
+  fit.mean_cool = sum_cool / static_cast<double>( live );
+  fit.mean_warm = sum_warm / static_cast<double>( live );
+  const double span = fit.mean_warm - fit.mean_cool;
+  if ( std::abs( span ) < min_span )
+    return fit;
+
+  fit.gain.assign( pixel_count, 1.0 );
+  fit.offset.assign( pixel_count, 0.0 );
+  fit.min_gain = max_gain;
+  fit.max_gain = 1.0 / max_gain;
+  double gain_sum = 0.0, gain_sum_sq = 0.0;
+  size_t fitted = 0;
+  for ( size_t i = 0; i < pixel_count; ++i ) {
+    if ( isDead( i ) )
+      continue;
+    const double pixel_span = warm[i] - cool[i];
+    // Same sign as the scene span and within the plausible gain range;
+    // otherwise the pixel did not follow the scene and is left alone.
+    const double gain = pixel_span != 0.0 ? span / pixel_span : 0.0;
+    if ( !( gain >= 1.0 / max_gain && gain <= max_gain ) ) {
+      ++fit.unresponsive;
+      continue;
+    }
+    fit.gain[i] = gain;
+    fit.offset[i] = fit.mean_cool - gain * cool[i];
+    fit.min_gain = std::min( fit.min_gain, gain );
+    fit.max_gain = std::max( fit.max_gain, gain );
+    gain_sum += gain;
+    gain_sum_sq += gain * gain;
+    ++fitted;
+  }
+  if ( fitted > 0 ) {
+    const double mean = gain_sum / static_cast<double>( fitted );
+    fit.gain_stddev =
+        std::sqrt( std::max( 0.0, gain_sum_sq / static_cast<double>( fitted ) - mean * mean ) );
+  } else {
+    fit.min_gain = fit.max_gain = 1.0;
+  }
+  return fit;
+}
+
+NonUniformityCorrection toNonUniformityCorrection( const NonUniformityFit &f )
+{
+  return NonUniformityCorrection( f.width, f.height, f.gain, f.offset );
+}
+
+} // namespace openseekthermal::tools
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Two-point non-uniformity fit shared by the calibration tooling.
+//
+// From per-pixel averages A_i (cool scene) and B_i (warm scene) of two uniform
+// scenes, each pixel gets the gain and offset that map its readings onto the
+// scene means Ā and B̄:
+//
+//     gain_i   = (B̄ - Ā) / (B_i - A_i)
+//     offset_i = Ā - gain_i · A_i
+//
+// Application at runtime (after flat-field and vignette correction):
+//     corrected_pixel = gain_i · pixel + offset_i
+
+#ifndef OPENSEEKTHERMAL_TOOLS_FIT_NON_UNIFORMITY_HPP
+#define OPENSEEKTHERMAL_TOOLS_FIT_NON_UNIFORMITY_HPP
+
+#include "openseekthermal/non_uniformity_correction.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace openseekthermal::tools
+{
+
+struct NonUniformityFit {
+  int width = 0;
+  int height = 0;
+  std::vector<double> gain;
+  std::vector<double> offset;
+  double mean_cool = 0.0; //!< Ā
+  double mean_warm = 0.0; //!< B̄
+  //! Pixels left uncorrected (gain 1, offset 0) because their span was too
+  //! small or their gain implausible; dead pixels are not counted.
+  size_t unresponsive = 0;
+  double min_gain = 0.0;
+  double max_gain = 0.0;
+  double gain_stddev = 0.0;
+};
+
+/*!
+ * Fit per-pixel gains and offsets to the averaged cool and warm frames.
+ * Pixels whose gain falls outside [1 / max_gain, max_gain] are treated as
+ * unresponsive and left uncorrected.
+ *
+ * @param dead_mask May be null. When provided, any `true` entry is excluded
+ *        from the scene means and left uncorrected.
+ * @return An empty fit (no gains) if the scene means are less than
+ *         `min_span` counts apart.
+ */
+NonUniformityFit fitNonUniformity( const std::vector<double> &cool, const std::vector<double> &warm,
+                                   int width, int height, double min_span = 50.0,
+                                   double max_gain = 2.0,
+                                   const std::vector<bool> *dead_mask = nullptr );
+
+//! Convert a fit result into the serializable NonUniformityCorrection.
+NonUniformityCorrection toNonUniformityCorrection( const NonUniformityFit &f );
+
+} // namespace openseekthermal::tools
+
+#endif // OPENSEEKTHERMAL_TOOLS_FIT_NON_UNIFORMITY_HPP
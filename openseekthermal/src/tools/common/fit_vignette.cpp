@@ -3,8 +3,11 @@
 
 #include "fit_vignette.hpp"
 
+#include "parallel_rows.hpp"
+
 #include <algorithm>
 #include <cmath>
+#include <functional>
 
 namespace openseekthermal::tools
 {
@@ -57,6 +60,57 @@ bool solveLinear( std::vector<double> &A, std::vector<double> &b, int N )
   return true;
 }
 
+namespace
+{
+
+//! Rows per band of forEachRowBand().
+constexpr int kBandRows = 8;
+
+//! Sum `size` values over the rows: `fn( row_begin, row_end, sums )` adds the
+//! values of a band to `sums`. Bands run in parallel; their partial sums are
+//! added in band order, so the result is deterministic.
+std::vector<double> sumRows( int height, size_t size,
+                             const std::function<void( int, int, double * )> &fn )
+{
+  const int bands = ( height + kBandRows - 1 ) / kBandRows;
+  std::vector<double> partial( static_cast<size_t>( bands ) * size, 0.0 );
+  forEachRowBand( height, kBandRows, [&]( int band, int begin, int end ) {
+    fn( begin, end, partial.data() + band * size );
+  } );
+  std::vector<double> sums( size, 0.0 );
+  for ( int band = 0; band < bands; ++band ) {
+    for ( size_t k = 0; k < size; ++k ) sums[k] += partial[band * size + k];
+  }
+  return sums;
+}
+
+//! Σ a[i]·b[i] in four interleaved lanes. Unlike a single accumulator this
+//! needs no reassociation of the additions to be vectorized.
+double dot( const double *a, const double *b, int n )
+{
+  double lane[4] = { 0.0, 0.0, 0.0, 0.0 };
+  int i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    for ( int l = 0; l < 4; ++l ) lane[l] += a[i + l] * b[i + l];
+  }
+  for ( ; i < n; ++i ) lane[0] += a[i] * b[i];
+  return ( lane[0] + lane[1] ) + ( lane[2] + lane[3] );
+}
+
+//! Σ a[i] in four interleaved lanes, see dot().
+double sum( const double *a, int n )
+{
+  double lane[4] = { 0.0, 0.0, 0.0, 0.0 };
+  int i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    for ( int l = 0; l < 4; ++l ) lane[l] += a[i + l];
+  }
+  for ( ; i < n; ++i ) lane[0] += a[i];
+  return ( lane[0] + lane[1] ) + ( lane[2] + lane[3] );
+}
+
+} // namespace
+
 RadialFit fitRadialPolynomial( const std::vector<double> &avg, int width, int height, int degree,
                                bool fit_center, const std::vector<bool> *dead_mask )
 {
@@ -75,39 +129,57 @@ RadialFit fitRadialPolynomial( const std::vector<double> &avg, int width, int he
   const int N = degree + 1;
   const size_t P = static_cast<size_t>( width ) * height;
 
-  std::vector<bool> live( P, true );
+  // Pixel weights (1 or 0) instead of branches keep the inner loops
+  // vectorizable.
+  std::vector<double> live( P, 1.0 );
   if ( dead_mask ) {
-    for ( size_t i = 0; i < P; ++i ) live[i] = !( *dead_mask )[i];
+    for ( size_t i = 0; i < P; ++i ) live[i] = ( *dead_mask )[i] ? 0.0 : 1.0;
   }
 
   std::vector<double> u( P, 0.0 );
   auto computeU = [&]() {
-    for ( int y = 0; y < height; ++y ) {
-      for ( int x = 0; x < width; ++x ) {
-        const double dx = x - fit.cx;
-        const double dy = y - fit.cy;
-        u[y * width + x] = ( dx * dx + dy * dy ) / fit.r2_max;
+    const double cx = fit.cx, cy = fit.cy, inv_r2_max = 1.0 / fit.r2_max;
+    forEachRowBand( height, kBandRows, [&]( int, int begin, int end ) {
+      for ( int y = begin; y < end; ++y ) {
+        const double dy = y - cy;
+        double *row = u.data() + static_cast<size_t>( y ) * width;
+        for ( int x = 0; x < width; ++x ) {
+          const double dx = x - cx;
+          row[x] = ( dx * dx + dy * dy ) * inv_r2_max;
+        }
       }
-    }
+    } );
   };
 
-  auto solveCoeffs = [&]( const std::vector<bool> &include ) -> bool {
-    std::vector<double> A( N * N, 0.0 );
-    std::vector<double> b( N, 0.0 );
-    std::vector<double> basis( N );
-    for ( size_t i = 0; i < P; ++i ) {
-      if ( !include[i] )
-        continue;
-      double up_i = 1.0;
-      for ( int k = 0; k < N; ++k ) {
-        basis[k] = up_i;
-        up_i *= u[i];
-      }
-      const double y_i = avg[i];
-      for ( int r = 0; r < N; ++r ) {
-        b[r] += basis[r] * y_i;
-        for ( int c = 0; c < N; ++c ) A[r * N + c] += basis[r] * basis[c];
+  // The normal matrix of the polynomial basis is a Hankel matrix,
+  // A[r][c] = Σ w·u^(r+c), so per pixel only the 2N-1 moments of u and the N
+  // right-hand sides Σ w·u^r·avg are accumulated instead of N² products.
+  // Returns the moments followed by the right-hand sides.
+  auto sumMoments = [&]( const std::vector<double> &weight ) {
+    const int moments = 2 * N - 1;
+    return sumRows( height, moments + N, [&]( int begin, int end, double *sums ) {
+      std::vector<double> power( width );
+      for ( int y = begin; y < end; ++y ) {
+        const size_t row = static_cast<size_t>( y ) * width;
+        const double *u_row = u.data() + row;
+        const double *avg_row = avg.data() + row;
+        std::copy( weight.begin() + row, weight.begin() + row + width, power.begin() );
+        for ( int k = 0; k < moments; ++k ) {
+          sums[k] += sum( power.data(), width );
+          if ( k < N )
+            sums[moments + k] += dot( power.data(), avg_row, width );
+          for ( int x = 0; x < width; ++x ) power[x] *= u_row[x];
+        }
       }
+    } );
+  };
+
+  auto solveCoeffs = [&]( const std::vector<double> &include ) -> bool {
+    const std::vector<double> sums = sumMoments( include );
+    std::vector<double> A( N * N );
+    std::vector<double> b( sums.begin() + 2 * N - 1, sums.end() );
+    for ( int r = 0; r < N; ++r ) {
+      for ( int c = 0; c < N; ++c ) A[r * N + c] = sums[r + c];
     }
     if ( !solveLinear( A, b, N ) )
       return false;
@@ -115,6 +187,20 @@ RadialFit fitRadialPolynomial( const std::vector<double> &avg, int width, int he
     return true;
   };
 
+  // model = Σ c_k u^k for every pixel, by Horner's scheme.
+  std::vector<double> model( P, 0.0 );
+  auto computeModel = [&]() {
+    forEachRowBand( height, kBandRows, [&]( int, int begin, int end ) {
+      const size_t first = static_cast<size_t>( begin ) * width;
+      const size_t last = static_cast<size_t>( end ) * width;
+      for ( size_t i = first; i < last; ++i ) {
+        double v = fit.coeffs[degree];
+        for ( int k = degree - 1; k >= 0; --k ) v = v * u[i] + fit.coeffs[k];
+        model[i] = v;
+      }
+    } );
+  };
+
   computeU();
   if ( !solveCoeffs( live ) )
     return fit; // degenerate
@@ -128,33 +214,31 @@ RadialFit fitRadialPolynomial( const std::vector<double> &avg, int width, int he
     // Build 2×2 normal equations for the (cx, cy) update.
     // ∂model/∂cx = (-2 (x - cx) / r²_max) · D(u)
     // where D(u) = Σ_{k≥1} c_k · k · u^(k-1).
-    double JJxx = 0.0, JJxy = 0.0, JJyy = 0.0;
-    double Jrx = 0.0, Jry = 0.0;
-    for ( int y = 0; y < height; ++y ) {
-      for ( int x = 0; x < width; ++x ) {
-        const size_t i = static_cast<size_t>( y ) * width + x;
-        if ( !live[i] )
-          continue;
-        const double ui = u[i];
-        double Du = 0.0;
-        double upow = 1.0; // u^(k-1) starting at k=1
-        double model = fit.coeffs[0];
-        for ( int k = 1; k <= degree; ++k ) {
-          Du += fit.coeffs[k] * k * upow;
-          upow *= ui;
-          model += fit.coeffs[k] * upow;
+    const std::vector<double> J = sumRows( height, 5, [&]( int begin, int end, double *sums ) {
+      std::vector<double> Jx( width ), Jy( width ), res( width );
+      for ( int y = begin; y < end; ++y ) {
+        const size_t row = static_cast<size_t>( y ) * width;
+        for ( int x = 0; x < width; ++x ) {
+          const size_t i = row + x;
+          const double ui = u[i];
+          double Du = degree * fit.coeffs[degree];
+          for ( int k = degree - 1; k >= 1; --k ) Du = Du * ui + k * fit.coeffs[k];
+          double m = fit.coeffs[degree];
+          for ( int k = degree - 1; k >= 0; --k ) m = m * ui + fit.coeffs[k];
+          // Dead pixels get zero Jacobian rows, which drops them from every sum.
+          const double factor = -2.0 / fit.r2_max * Du * live[i];
+          Jx[x] = factor * ( x - fit.cx );
+          Jy[x] = factor * ( y - fit.cy );
+          res[x] = avg[i] - m;
         }
-        const double resi = avg[i] - model;
-        const double factor = -2.0 / fit.r2_max * Du;
-        const double Jx = factor * ( x - fit.cx );
-        const double Jy = factor * ( y - fit.cy );
-        JJxx += Jx * Jx;
-        JJxy += Jx * Jy;
-        JJyy += Jy * Jy;
-        Jrx += Jx * resi;
-        Jry += Jy * resi;
+        sums[0] += dot( Jx.data(), Jx.data(), width );
+        sums[1] += dot( Jx.data(), Jy.data(), width );
+        sums[2] += dot( Jy.data(), Jy.data(), width );
+        sums[3] += dot( Jx.data(), res.data(), width );
+        sums[4] += dot( Jy.data(), res.data(), width );
       }
-    }
+    } );
+    const double JJxx = J[0], JJxy = J[1], JJyy = J[2], Jrx = J[3], Jry = J[4];
     const double det = JJxx * JJyy - JJxy * JJxy;
     if ( std::abs( det ) < 1e-18 )
       break; // singular — leave center where it is
@@ -180,19 +264,12 @@ RadialFit fitRadialPolynomial( const std::vector<double> &avg, int width, int he
   // Robust pass: compute residuals at the current (cx, cy, coeffs), reject
   // pixels above 3·MAD, and refit coefficients. The center is not re-updated
   // here — by this point it's already converged to sub-pixel tolerance.
-  std::vector<double> residuals( P, 0.0 );
+  computeModel();
   std::vector<double> abs_res_live;
   abs_res_live.reserve( P );
   for ( size_t i = 0; i < P; ++i ) {
-    double model = 0.0;
-    double up_i = 1.0;
-    for ( int k = 0; k < N; ++k ) {
-      model += fit.coeffs[k] * up_i;
-      up_i *= u[i];
-    }
-    residuals[i] = avg[i] - model;
-    if ( live[i] )
-      abs_res_live.push_back( std::abs( residuals[i] ) );
+    if ( live[i] != 0.0 )
+      abs_res_live.push_back( std::abs( avg[i] - model[i] ) );
   }
   double mad = 0.0;
   if ( !abs_res_live.empty() ) {
@@ -202,23 +279,17 @@ RadialFit fitRadialPolynomial( const std::vector<double> &avg, int width, int he
   }
   // 1.4826 converts MAD to a stddev-equivalent for normal residuals.
   const double cutoff = std::max( 1.0, 3.0 * 1.4826 * mad );
-  std::vector<bool> include_robust( P, false );
+  std::vector<double> include_robust( P, 0.0 );
   for ( size_t i = 0; i < P; ++i )
-    include_robust[i] = live[i] && std::abs( residuals[i] ) <= cutoff;
+    include_robust[i] = live[i] != 0.0 && std::abs( avg[i] - model[i] ) <= cutoff ? 1.0 : 0.0;
   solveCoeffs( include_robust );
 
   // Compute the model's spatial mean — needed as the additive constant when
   // applying the correction so that overall image intensity is preserved.
+  // Σ model = Σ_k c_k · Σ u^k, with the moments of u over all pixels.
+  const std::vector<double> moments = sumMoments( std::vector<double>( P, 1.0 ) );
   double sum = 0.0;
-  for ( size_t i = 0; i < P; ++i ) {
-    double model = 0.0;
-    double up_i = 1.0;
-    for ( int k = 0; k < N; ++k ) {
-      model += fit.coeffs[k] * up_i;
-      up_i *= u[i];
-    }
-    sum += model;
-  }
+  for ( int k = 0; k < N; ++k ) sum += fit.coeffs[k] * moments[k];
   fit.mean_model = sum / static_cast<double>( P );
   return fit;
 }
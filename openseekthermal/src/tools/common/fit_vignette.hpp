@@ -46,6 +46,8 @@ bool solveLinear( std::vector<double> &A, std::vector<double> &b, int N );
  * in the center but linear in the coefficients, so the center is refined by
  * Gauss-Newton, alternating with a closed-form coefficient resolve, followed by
  * one robust 3·MAD refit. r²_max is fixed at the image-center corner distance².
+ * The per-pixel sums are computed in bands of rows on all cores and added in a
+ * fixed order, so the result does not depend on the number of threads.
  *
  * @param dead_mask May be null. When provided, any `true` entry is excluded
  *        from every fit pass and from the MAD computation.
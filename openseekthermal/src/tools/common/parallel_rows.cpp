@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "parallel_rows.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace openseekthermal::tools
+{
+
+void forEachRowBand( int height, int band_rows, const std::function<void( int, int, int )> &fn )
+{
+  const int bands = ( height + band_rows - 1 ) / band_rows;
+  std::atomic<int> next{ 0 };
+  const auto work = [&]() {
+    for ( int band = next++; band < bands; band = next++ ) {
+      const int begin = band * band_rows;
+      fn( band, begin, std::min( begin + band_rows, height ) );
+    }
+  };
+  const int thread_count =
+      std::min( bands, static_cast<int>( std::max( 1u, std::thread::hardware_concurrency() ) ) );
+  std::vector<std::thread> threads;
+  for ( int t = 1; t < thread_count; ++t ) threads.emplace_back( work );
+  work();
+  for ( auto &thread : threads ) thread.join();
+}
+
+} // namespace openseekthermal::tools
@@ -0,0 +1,26 @@
+// Copyright (c) 2026 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Row-parallel execution shared by the calibration fits.
+//
+// The rows of a frame are split into bands of a fixed number of rows, which
+// the available cores pick up one at a time. The bands do not depend on the
+// number of threads, so results accumulated per band and combined in band
+// order are deterministic.
+
+#ifndef OPENSEEKTHERMAL_TOOLS_PARALLEL_ROWS_HPP
+#define OPENSEEKTHERMAL_TOOLS_PARALLEL_ROWS_HPP
+
+#include <functional>
+
+namespace openseekthermal::tools
+{
+
+//! Run `fn( band, row_begin, row_end )` for every band of `band_rows` rows of
+//! a frame `height` rows high, spread over all cores. Returns once all bands
+//! are done.
+void forEachRowBand( int height, int band_rows, const std::function<void( int, int, int )> &fn );
+
+} // namespace openseekthermal::tools
+
+#endif // OPENSEEKTHERMAL_TOOLS_PARALLEL_ROWS_HPP
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Converts a unified calibration between the editable INI form and the
+// memory-mappable binary container (see saveCameraCalibrationBinary()). The
+// input format is detected; the output is INI if its name ends in .ini and
+// binary otherwise.
+
+#include "openseekthermal/camera_calibration.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace openseekthermal;
+
+namespace
+{
+
+void printUsage( const char *argv0 )
+{
+  std::cout << "Usage: " << argv0 << " --width W --height H INPUT OUTPUT\n"
+            << "  Convert a calibration between INI and the binary container.\n"
+            << "  --width W, --height H  camera frame size the calibration is for\n"
+            << "  INPUT                  .ini or binary calibration (detected)\n"
+            << "  OUTPUT                 written as INI if it ends in .ini, binary otherwise\n"
+            << "  -h | --help            show this message\n";
+}
+
+} // namespace
+
+int main( int argc, char **argv )
+{
+  int width = 0;
+  int height = 0;
+  fs::path input;
+  fs::path output;
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string arg = argv[i];
+    if ( arg == "--width" && i + 1 < argc ) {
+      width = std::stoi( argv[++i] );
+    } else if ( arg == "--height" && i + 1 < argc ) {
+      height = std::stoi( argv[++i] );
+    } else if ( arg == "-h" || arg == "--help" ) {
+      printUsage( argv[0] );
+      return 0;
+    } else if ( input.empty() ) {
+      input = arg;
+    } else if ( output.empty() ) {
+      output = arg;
+    } else {
+      std::cerr << "Unknown argument: " << arg << "\n\n";
+      printUsage( argv[0] );
+      return 2;
+    }
+  }
+  if ( width <= 0 || height <= 0 || input.empty() || output.empty() ) {
+    printUsage( argv[0] );
+    return 2;
+  }
+
+  try {
+    const CameraCalibration cal = loadCameraCalibration( input, width, height );
+    if ( output.extension() == ".ini" ) {
+      saveCameraCalibration( output, cal, "Converted from " + input.filename().string() );
+    } else {
+      saveCameraCalibrationBinary( output, cal );
+    }
+    // Round-trip self-check.
+    loadCameraCalibration( output, width, height );
+  } catch ( const std::exception &e ) {
+    std::cerr << "Conversion failed: " << e.what() << "\n";
+    return 1;
+  }
+  std::cout << "Wrote " << output << "\n";
+  return 0;
+}
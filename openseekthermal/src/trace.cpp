@@ -0,0 +1,279 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal/trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace openseekthermal
+{
+
+namespace
+{
+
+enum class EventPhase : char { Complete = 'X', Instant = 'i', Counter = 'C' };
+
+//! Fields are relaxed atomics so a concurrent export reads torn events
+//! instead of racing; those are discarded using the buffer head.
+struct TraceEvent {
+  std::atomic<const char *> name{ nullptr };
+  std::atomic<int64_t> timestamp_ns{ 0 };
+  std::atomic<int64_t> duration_ns{ 0 }; //!< Or the argument / counter value.
+  std::atomic<char> phase{ 0 };
+};
+
+//! Single-producer ring buffer owned by one thread.
+struct ThreadBuffer {
+  explicit ThreadBuffer( int id ) : thread_id( id ) { }
+
+  void push( EventPhase phase, const char *name, int64_t timestamp_ns, int64_t value ) noexcept
+  {
+    const uint64_t index = head.load( std::memory_order_relaxed );
+    TraceEvent &event = events[index % kTraceEventsPerThread];
+    event.name.store( name, std::memory_order_relaxed );
+    event.timestamp_ns.store( timestamp_ns, std::memory_order_relaxed );
+    event.duration_ns.store( value, std::memory_order_relaxed );
+    event.phase.store( static_cast<char>( phase ), std::memory_order_relaxed );
+    head.store( index + 1, std::memory_order_release );
+  }
+
+  const int thread_id;
+  std::string thread_name; //!< Guarded by the registry mutex.
+  bool exited = false;     //!< Guarded by the registry mutex.
+  std::atomic<uint64_t> head{ 0 };
+  std::atomic<uint64_t> cleared{ 0 }; //!< Events before this index were cleared.
+  std::array<TraceEvent, kTraceEventsPerThread> events;
+};
+
+struct TraceRegistry {
+  std::mutex mutex;
+  //! Shared so buffers of exited threads can still be exported.
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  size_t exited_count = 0; //!< Buffers of exited threads in `buffers`.
+  int next_thread_id = 1;
+  std::set<std::string, std::less<>> names;
+};
+
+TraceRegistry &registry()
+{
+  static TraceRegistry instance;
+  return instance;
+}
+
+//! Keeps the buffer of a thread for export after the thread exits, and frees
+//! the oldest kept buffer beyond kTraceExitedThreads.
+struct ThreadBufferOwner {
+  ~ThreadBufferOwner()
+  {
+    if ( buffer == nullptr )
+      return;
+    TraceRegistry &trace = registry();
+    std::lock_guard lock( trace.mutex );
+    buffer->exited = true;
+    if ( ++trace.exited_count <= kTraceExitedThreads )
+      return;
+    trace.buffers.erase( std::find_if( trace.buffers.begin(), trace.buffers.end(),
+                                       []( const auto &b ) { return b->exited; } ) );
+    --trace.exited_count;
+  }
+
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+//! The calling thread's buffer, allocated on first use; null if that fails.
+ThreadBuffer *threadBuffer() noexcept
+{
+  thread_local ThreadBufferOwner owner;
+  if ( owner.buffer == nullptr ) {
+    try {
+      TraceRegistry &trace = registry();
+      std::lock_guard lock( trace.mutex );
+      auto buffer = std::make_shared<ThreadBuffer>( trace.next_thread_id );
+      trace.buffers.push_back( buffer );
+      ++trace.next_thread_id;
+      owner.buffer = std::move( buffer );
+    } catch ( ... ) {
+      return nullptr;
+    }
+  }
+  return owner.buffer.get();
+}
+
+int64_t toNanoseconds( std::chrono::steady_clock::time_point time )
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>( time.time_since_epoch() ).count();
+}
+
+void writeJsonString( std::ostream &out, const char *value )
+{
+  out << '"';
+  for ( const char *c = value; *c != '\0'; ++c ) {
+    if ( *c == '"' || *c == '\\' )
+      out << '\\' << *c;
+    else if ( static_cast<unsigned char>( *c ) < 0x20 )
+      out << ' ';
+    else
+      out << *c;
+  }
+  out << '"';
+}
+
+void writeMicroseconds( std::ostream &out, int64_t ns )
+{
+  // Fixed three decimals without going through floating point.
+  const int64_t fraction = ns % 1000;
+  out << ns / 1000 << '.' << static_cast<char>( '0' + fraction / 100 )
+      << static_cast<char>( '0' + fraction / 10 % 10 ) << static_cast<char>( '0' + fraction % 10 );
+}
+
+} // namespace
+
+void traceComplete( const char *name, std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end ) noexcept
+{
+  ThreadBuffer *buffer = threadBuffer();
+  if ( buffer == nullptr )
+    return;
+  const int64_t begin_ns = toNanoseconds( begin );
+  buffer->push( EventPhase::Complete, name, begin_ns, toNanoseconds( end ) - begin_ns );
+}
+
+void traceInstant( const char *name, int64_t arg ) noexcept
+{
+  if ( ThreadBuffer *buffer = threadBuffer() )
+    buffer->push( EventPhase::Instant, name, toNanoseconds( std::chrono::steady_clock::now() ),
+                  arg );
+}
+
+void traceCounter( const char *name, int64_t value ) noexcept
+{
+  if ( ThreadBuffer *buffer = threadBuffer() )
+    buffer->push( EventPhase::Counter, name, toNanoseconds( std::chrono::steady_clock::now() ),
+                  value );
+}
+
+const char *internTraceName( const std::string &name )
+{
+  TraceRegistry &trace = registry();
+  std::lock_guard lock( trace.mutex );
+  return trace.names.insert( name ).first->c_str();
+}
+
+void setTraceThreadName( const std::string &name )
+{
+  ThreadBuffer *buffer = threadBuffer();
+  if ( buffer == nullptr )
+    throw std::bad_alloc();
+  std::lock_guard lock( registry().mutex );
+  buffer->thread_name = name;
+}
+
+void writeChromeTrace( std::ostream &out )
+{
+  TraceRegistry &trace = registry();
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard lock( trace.mutex );
+    buffers = trace.buffers;
+  }
+  const int pid = static_cast<int>( ::getpid() );
+  bool first = true;
+  const auto separator = [&]() {
+    out << ( first ? "\n" : ",\n" );
+    first = false;
+  };
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for ( const auto &buffer : buffers ) {
+    std::string thread_name;
+    {
+      std::lock_guard lock( trace.mutex );
+      thread_name = buffer->thread_name;
+    }
+    if ( !thread_name.empty() ) {
+      separator();
+      out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+          << ",\"tid\":" << buffer->thread_id << ",\"args\":{\"name\":";
+      writeJsonString( out, thread_name.c_str() );
+      out << "}}";
+    }
+
+    const uint64_t head = buffer->head.load( std::memory_order_acquire );
+    uint64_t begin = head > kTraceEventsPerThread ? head - kTraceEventsPerThread : 0;
+    begin = std::max( begin, buffer->cleared.load( std::memory_order_relaxed ) );
+    struct Copy {
+      const char *name;
+      int64_t timestamp_ns;
+      int64_t value;
+      char phase;
+    };
+    std::vector<Copy> events;
+    events.reserve( head - begin );
+    for ( uint64_t i = begin; i < head; ++i ) {
+      const TraceEvent &event = buffer->events[i % kTraceEventsPerThread];
+      events.push_back( { event.name.load( std::memory_order_relaxed ),
+                          event.timestamp_ns.load( std::memory_order_relaxed ),
+                          event.duration_ns.load( std::memory_order_relaxed ),
+                          event.phase.load( std::memory_order_relaxed ) } );
+    }
+    // Events the writer overwrote (or is overwriting) while we copied.
+    std::atomic_thread_fence( std::memory_order_acquire );
+    const uint64_t new_head = buffer->head.load( std::memory_order_relaxed );
+    const uint64_t valid =
+        new_head >= kTraceEventsPerThread ? new_head - kTraceEventsPerThread + 1 : 0;
+    for ( uint64_t i = std::max( begin, valid ); i < head; ++i ) {
+      const Copy &event = events[i - begin];
+      if ( event.name == nullptr )
+        continue;
+      separator();
+      out << "{\"ph\":\"" << event.phase << "\",\"name\":";
+      writeJsonString( out, event.name );
+      out << ",\"pid\":" << pid << ",\"tid\":" << buffer->thread_id << ",\"ts\":";
+      writeMicroseconds( out, event.timestamp_ns );
+      switch ( static_cast<EventPhase>( event.phase ) ) {
+      case EventPhase::Complete:
+        out << ",\"dur\":";
+        writeMicroseconds( out, event.value );
+        break;
+      case EventPhase::Instant:
+        out << ",\"s\":\"t\",\"args\":{\"value\":" << event.value << "}";
+        break;
+      case EventPhase::Counter:
+        out << ",\"args\":{\"value\":" << event.value << "}";
+        break;
+      }
+      out << "}";
+    }
+  }
+  out << "\n]}\n";
+}
+
+void writeChromeTraceFile( const std::string &path )
+{
+  std::ofstream file( path, std::ios::trunc );
+  if ( !file )
+    throw std::runtime_error( "Failed to open '" + path + "' for writing" );
+  writeChromeTrace( file );
+  if ( !file.flush() )
+    throw std::runtime_error( "Failed to write '" + path + "'" );
+}
+
+void clearTrace() noexcept
+{
+  TraceRegistry &trace = registry();
+  std::lock_guard lock( trace.mutex );
+  for ( const auto &buffer : trace.buffers )
+    buffer->cleared.store( buffer->head.load( std::memory_order_acquire ),
+                           std::memory_order_relaxed );
+}
+
+} // namespace openseekthermal
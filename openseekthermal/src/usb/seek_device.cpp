@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 #include "openseekthermal/detail/usb/seek_device.hpp"
 #include "openseekthermal/detail/exceptions.hpp"
+#include "openseekthermal/detail/usb/device_traits.hpp"
 
 std::ostream &operator<<( std::ostream &os, const openseekthermal::SeekDevice &device )
 {
@@ -31,45 +32,21 @@ namespace openseekthermal
 {
 int SeekDevice::getFrameWidth() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 206; // 208 with padding
-  case Type::SeekThermalNano300:
-  case Type::SeekThermalCompactPro:
-    return 320; // 342 with padding, 320 without
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "getFrameWidth not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "getFrameWidth",
+                            []( auto traits ) { return decltype( traits )::kWidth; } );
 }
 
 int SeekDevice::getFrameHeight() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 156; // 156 with padding
-  case Type::SeekThermalNano300:
-  case Type::SeekThermalCompactPro:
-    return 240; // 260 with padding, 240 without
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "getFrameHeight not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "getFrameHeight",
+                            []( auto traits ) { return decltype( traits )::kHeight; } );
 }
 
 Framerate SeekDevice::getMaxFramerate() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 8;
-  case Type::SeekThermalNano300:
-    return 25;
-  case Type::SeekThermalCompactPro:
-    return 15;
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "getMaxFramerate not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "getMaxFramerate", []( auto traits ) {
+    return Framerate( decltype( traits )::kMaxFramerate );
+  } );
 }
 
 uint16_t SeekDevice::_getVendorID() const
@@ -81,89 +58,42 @@ uint16_t SeekDevice::_getVendorID() const
 
 uint16_t SeekDevice::_getProductID() const
 {
-  {
-    switch ( type ) {
-    case Type::SeekThermalCompact:
-      return 0x0010;
-    case Type::SeekThermalCompactPro:
-    case Type::SeekThermalNano300:
-      return 0x0011;
-    default:
-      break;
-    }
-    throw InvalidDeviceError( "_getProductID not implemented for" + to_string( type ) );
-  }
+  return visitDeviceTraits( type, "_getProductID",
+                            []( auto traits ) { return decltype( traits )::kProductID; } );
 }
 
 int SeekDevice::_getFrameTransferTotalSize() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 64896; // 208 * 156 * 2
-  case Type::SeekThermalCompactPro:
-  case Type::SeekThermalNano300:
-    return 177840; // 260 * 342 * 2
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "_getFrameTransferTotalSize not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "_getFrameTransferTotalSize", []( auto traits ) {
+    return decltype( traits )::kTransferTotalSize;
+  } );
 }
 
 int SeekDevice::_getFrameTransferRequestSize() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 16224;
-  case Type::SeekThermalCompactPro:
-  case Type::SeekThermalNano300:
-    return 13680;
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "_getFrameTransferRequestSize not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "_getFrameTransferRequestSize", []( auto traits ) {
+    return decltype( traits )::kTransferRequestSize;
+  } );
 }
 
 int SeekDevice::_getFrameHeaderSize() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 0;
-  case Type::SeekThermalCompactPro:
-  case Type::SeekThermalNano300:
-    return 2736; // 342 * 4 * 2
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "_getFrameHeaderSize not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "_getFrameHeaderSize", []( auto traits ) {
+    return decltype( traits )::kFrameHeaderSize;
+  } );
 }
 
 uint32_t SeekDevice::_getFrameTransferDeviceRequestSize() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 32448; // 208 * 156
-  case Type::SeekThermalCompactPro:
-  case Type::SeekThermalNano300:
-    return 88920; // 260 * 342
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "_getFrameTransferDeviceRequestSize not implemented for" +
-                            to_string( type ) );
+  return visitDeviceTraits( type, "_getFrameTransferDeviceRequestSize", []( auto traits ) {
+    return decltype( traits )::kTransferDeviceRequestSize;
+  } );
 }
 
 int SeekDevice::_getRowStep() const
 {
-  switch ( type ) {
-  case Type::SeekThermalCompact:
-    return 416; // 208 * 2 bytes per pixel
-  case Type::SeekThermalCompactPro:
-  case Type::SeekThermalNano300:
-    return 684; // 342 * 2 bytes per pixel
-  default:
-    break;
-  }
-  throw InvalidDeviceError( "_getRowStep not implemented for" + to_string( type ) );
+  return visitDeviceTraits( type, "_getRowStep",
+                            []( auto traits ) { return decltype( traits )::kRowStep; } );
 }
 
 std::string to_string( SeekDevice::Type type )
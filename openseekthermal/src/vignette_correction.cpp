@@ -4,6 +4,7 @@
 #include "openseekthermal/vignette_correction.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 namespace openseekthermal
 {
@@ -22,6 +23,21 @@ double VignetteCorrection::evaluate( double x, double y ) const
   return model;
 }
 
+std::vector<int32_t> VignetteCorrection::computeOffsets() const
+{
+  std::vector<int32_t> table( static_cast<size_t>( width ) * height );
+  for ( int y = 0; y < height; ++y ) {
+    for ( int x = 0; x < width; ++x ) {
+      const double offset = std::clamp( ( mean_model - evaluate( x, y ) ) *
+                                            ( 1 << kOffsetFractionBits ),
+                                        -static_cast<double>( kMaxOffset ),
+                                        static_cast<double>( kMaxOffset ) );
+      table[static_cast<size_t>( y ) * width + x] = static_cast<int32_t>( std::lround( offset ) );
+    }
+  }
+  return table;
+}
+
 void VignetteCorrection::apply( uint16_t *frame ) const
 {
   if ( coeffs.empty() || r2_max <= 0.0 )
@@ -6,6 +6,7 @@
 
 #include <cairo/cairo.h>
 #include <gst/video/gstvideofilter.h>
+#include <openseekthermal/frame_scaler.hpp>
 
 G_BEGIN_DECLS
 
@@ -32,6 +33,15 @@ typedef enum {
 
 GType gst_openseekthermal_colormap_get_type( void );
 
+#define GST_TYPE_OPENSEEKTHERMAL_UPSCALE_METHOD ( gst_openseekthermal_upscale_method_get_type() )
+
+typedef enum {
+  GST_OPENSEEKTHERMAL_UPSCALE_BILINEAR = 0,
+  GST_OPENSEEKTHERMAL_UPSCALE_BICUBIC
+} GstOpenSeekThermalUpscaleMethod;
+
+GType gst_openseekthermal_upscale_method_get_type( void );
+
 typedef struct _GstOpenSeekThermalColorize GstOpenSeekThermalColorize;
 typedef struct _GstOpenSeekThermalColorizeClass GstOpenSeekThermalColorizeClass;
 
@@ -45,6 +55,8 @@ struct _GstOpenSeekThermalColorize {
   guint roi_width;
   guint roi_height;
   guint auto_range_frames;
+  guint upscale;
+  GstOpenSeekThermalUpscaleMethod upscale_method;
 
   /* derived per-format state, refreshed in set_info */
   gint out_format; /* GstVideoFormat as int to avoid header include */
@@ -66,6 +78,11 @@ struct _GstOpenSeekThermalColorize {
   guint index;
   gboolean first_frame;
 
+  /* 16-bit frame upscaled to the output size before colorization */
+  openseekthermal::FrameScaler *scaler;
+  guint16 *upscaled;
+  gsize upscaled_size;
+
   /* full-frame ARGB32 scratch + cairo surface, reused across frames */
   guint8 *scratch;
   gint scratch_w;
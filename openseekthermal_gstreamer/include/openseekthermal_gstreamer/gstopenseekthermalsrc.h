@@ -31,6 +31,8 @@ struct _GstOpenSeekThermalSrc {
   gboolean skip_invalid_frames;
   gboolean normalize;
   guint normalize_frame_count;
+  guint binning;
+  guint decimation;
   openseekthermal::SeekThermalCamera::SharedPtr camera;
 
   gboolean first_frame;
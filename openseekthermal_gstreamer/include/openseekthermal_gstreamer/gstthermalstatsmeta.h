@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef OPENSEEKTHERMAL_GSTREAMER_THERMALSTATSMETA_HPP
+#define OPENSEEKTHERMAL_GSTREAMER_THERMALSTATSMETA_HPP
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_THERMAL_STATS_META_HISTOGRAM_BINS 256
+
+/**
+ * GstThermalStatsMeta:
+ * @meta:           parent #GstMeta
+ * @min:            smallest pixel value
+ * @max:            largest pixel value
+ * @mean:           mean pixel value
+ * @sentinel_count: dead-pixel sentinels inpainted by the driver
+ * @histogram:      pixel count per bin of 65536 / GST_THERMAL_STATS_META_HISTOGRAM_BINS
+ *                  values
+ *
+ * Attached by openseekthermalsrc with the frame statistics the driver
+ * computed while processing the frame, so downstream elements do not have to
+ * scan the pixels. Values are in the camera's native units (e.g. centi-Kelvin)
+ * before any normalization; map them into buffer values with the
+ * #GstThermalScaleMeta if present.
+ *
+ * The API carries the video, size and colorspace tags, so elements that
+ * crop, scale or convert the frame drop it. Only whole-buffer copies keep it.
+ */
+typedef struct {
+  GstMeta meta;
+  guint16 min;
+  guint16 max;
+  gdouble mean;
+  guint sentinel_count;
+  guint32 histogram[GST_THERMAL_STATS_META_HISTOGRAM_BINS];
+} GstThermalStatsMeta;
+
+GType gst_thermal_stats_meta_api_get_type( void );
+#define GST_THERMAL_STATS_META_API_TYPE ( gst_thermal_stats_meta_api_get_type() )
+
+const GstMetaInfo *gst_thermal_stats_meta_get_info( void );
+#define GST_THERMAL_STATS_META_INFO ( gst_thermal_stats_meta_get_info() )
+
+#define gst_buffer_get_thermal_stats_meta( b )                                                     \
+  ( (GstThermalStatsMeta *)gst_buffer_get_meta( ( b ), GST_THERMAL_STATS_META_API_TYPE ) )
+
+//! Adds a zero-initialized meta for the caller to fill.
+GstThermalStatsMeta *gst_buffer_add_thermal_stats_meta( GstBuffer *buffer );
+
+G_END_DECLS
+
+#endif // OPENSEEKTHERMAL_GSTREAMER_THERMALSTATSMETA_HPP
@@ -16,6 +16,10 @@
  *   min-centikelvin=29000 max-centikelvin=31000 colormap=inferno \
  *   ! videoconvert ! autovideosink
  * ]| Fixed color range 290..310 K with the inferno colormap.
+ * |[
+ * gst-launch-1.0 openseekthermalsrc ! openseekthermalcolorize upscale=3 upscale-method=bicubic \
+ *   ! videoconvert ! autovideosink
+ * ]| Thermal data interpolated to three times the sensor resolution before colorization.
  */
 // Copyright (c) 2025 Stefan Fabian. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
@@ -27,6 +31,8 @@
 #include "openseekthermal_gstreamer/gstopenseekthermalcolorize.h"
 
 #include "openseekthermal_gstreamer/gstthermalscalemeta.h"
+#include "openseekthermal_gstreamer/gstthermalstatsmeta.h"
+#include <openseekthermal/trace.hpp>
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
@@ -43,6 +49,8 @@ enum {
   PROP_ROI_WIDTH,
   PROP_ROI_HEIGHT,
   PROP_AUTO_RANGE_FRAMES,
+  PROP_UPSCALE,
+  PROP_UPSCALE_METHOD,
   PROP_LAST
 };
 
@@ -53,6 +61,9 @@ enum {
 #define DEFAULT_ROI_HEIGHT 32u
 #define DEFAULT_AUTO_RANGE_FRAMES 8u
 #define MAX_AUTO_RANGE_FRAMES 256u
+#define DEFAULT_UPSCALE 1u
+#define MAX_UPSCALE 8u
+#define DEFAULT_UPSCALE_METHOD GST_OPENSEEKTHERMAL_UPSCALE_BILINEAR
 
 #define OPENSEEKTHERMALCOLORIZE_SINK_CAPS                                                          \
   "video/x-raw, format = (string)GRAY16_LE, "                                                      \
@@ -85,6 +96,19 @@ GType gst_openseekthermal_colormap_get_type( void )
   return type;
 }
 
+GType gst_openseekthermal_upscale_method_get_type( void )
+{
+  static GType type = 0;
+  if ( type == 0 ) {
+    static const GEnumValue values[] = {
+        { GST_OPENSEEKTHERMAL_UPSCALE_BILINEAR, "Bilinear", "bilinear" },
+        { GST_OPENSEEKTHERMAL_UPSCALE_BICUBIC, "Bicubic (Catmull-Rom)", "bicubic" },
+        { 0, NULL, NULL } };
+    type = g_enum_register_static( "GstOpenSeekThermalUpscaleMethod", values );
+  }
+  return type;
+}
+
 // cppcheck-suppress unknownMacro
 G_DEFINE_TYPE_WITH_CODE(
     GstOpenSeekThermalColorize, gst_openseekthermalcolorize, GST_TYPE_VIDEO_FILTER,
@@ -356,6 +380,57 @@ static void draw_overlay( GstOpenSeekThermalColorize *self, gint w, gint h, gint
   cairo_surface_flush( self->scratch_surface );
 }
 
+/* ----- upscaling ------------------------------------------------------- */
+
+/* Interpolate the 16-bit input to the output size, so the LUT is applied once
+ * per output pixel instead of scaling the colorized frame. Returns the input
+ * unchanged if the sizes match. */
+static const guint16 *upscale_input( GstOpenSeekThermalColorize *self, const guint16 *src, gint w,
+                                     gint h, gint *src_stride_bytes, gint out_w, gint out_h )
+{
+  if ( out_w == w && out_h == h )
+    return src;
+  const auto filter = self->upscale_method == GST_OPENSEEKTHERMAL_UPSCALE_BICUBIC
+                          ? openseekthermal::ScalingFilter::Bicubic
+                          : openseekthermal::ScalingFilter::Bilinear;
+  if ( self->scaler == nullptr || self->scaler->sourceWidth() != w ||
+       self->scaler->sourceHeight() != h || self->scaler->width() != out_w ||
+       self->scaler->height() != out_h || self->scaler->filter() != filter ) {
+    delete self->scaler;
+    self->scaler = new openseekthermal::FrameScaler( w, h, out_w, out_h, filter );
+  }
+  gsize size = static_cast<gsize>( out_w ) * static_cast<gsize>( out_h );
+  if ( self->upscaled_size != size ) {
+    self->upscaled = (guint16 *)g_realloc( self->upscaled, size * sizeof( guint16 ) );
+    self->upscaled_size = size;
+  }
+  self->scaler->scale( src, *src_stride_bytes / sizeof( guint16 ), self->upscaled, out_w );
+  *src_stride_bytes = out_w * static_cast<gint>( sizeof( guint16 ) );
+  return self->upscaled;
+}
+
+/* Multiply (direction == GST_PAD_SINK) or divide the width or height field of
+ * `s` by `factor`, for fixed values and ranges. */
+static void scale_size_field( GstStructure *s, const gchar *field, GstPadDirection direction,
+                              guint factor )
+{
+  const GValue *value = gst_structure_get_value( s, field );
+  if ( value == nullptr || factor == 1 )
+    return;
+  auto scale = [direction, factor]( gint size, gboolean round_up ) {
+    gint64 result = direction == GST_PAD_SINK ? static_cast<gint64>( size ) * factor
+                                              : ( size + ( round_up ? factor - 1 : 0 ) ) / factor;
+    return static_cast<gint>( std::clamp<gint64>( result, 1, G_MAXINT ) );
+  };
+  if ( G_VALUE_HOLDS_INT( value ) ) {
+    gst_structure_set( s, field, G_TYPE_INT, scale( g_value_get_int( value ), FALSE ), NULL );
+  } else if ( GST_VALUE_HOLDS_INT_RANGE( value ) ) {
+    gint min = scale( gst_value_get_int_range_min( value ), TRUE );
+    gint max = scale( gst_value_get_int_range_max( value ), FALSE );
+    gst_structure_set( s, field, GST_TYPE_INT_RANGE, min, std::max( min, max ), NULL );
+  }
+}
+
 /* ----- core transform -------------------------------------------------- */
 
 static inline guint cK_to_raw( double cK, double scale, double offset )
@@ -420,14 +495,17 @@ static GstFlowReturn gst_openseekthermalcolorize_transform_frame( GstVideoFilter
                                                                   GstVideoFrame *in_frame,
                                                                   GstVideoFrame *out_frame )
 {
+  OPENSEEKTHERMAL_TRACE_SCOPE( "openseekthermalcolorize::transform_frame" );
   GstOpenSeekThermalColorize *self = GST_OPENSEEKTHERMALCOLORIZE( filter );
   gint w = GST_VIDEO_FRAME_WIDTH( in_frame );
   gint h = GST_VIDEO_FRAME_HEIGHT( in_frame );
+  gint out_w = GST_VIDEO_FRAME_WIDTH( out_frame );
+  gint out_h = GST_VIDEO_FRAME_HEIGHT( out_frame );
   const guint16 *src = reinterpret_cast<const guint16 *>( GST_VIDEO_FRAME_PLANE_DATA( in_frame, 0 ) );
   gint src_stride = GST_VIDEO_FRAME_PLANE_STRIDE( in_frame, 0 );
 
-  if ( !ensure_scratch( self, w, h ) ) {
-    GST_ERROR_OBJECT( self, "Failed to allocate %dx%d scratch surface", w, h );
+  if ( !ensure_scratch( self, out_w, out_h ) ) {
+    GST_ERROR_OBJECT( self, "Failed to allocate %dx%d scratch surface", out_w, out_h );
     return GST_FLOW_ERROR;
   }
 
@@ -453,26 +531,31 @@ static GstFlowReturn gst_openseekthermalcolorize_transform_frame( GstVideoFilter
   gint roi_x = ( w - static_cast<gint>( roi_w ) ) / 2;
   gint roi_y = ( h - static_cast<gint>( roi_h ) ) / 2;
 
+  /* Frame min/max from the source's stats meta, mapped into buffer units
+   * (the normalization is increasing); scan only without it. */
   guint raw_min = 65535;
   guint raw_max = 0;
-  guint64 roi_sum_raw = 0;
-  guint roi_count = 0;
-  for ( gint y = 0; y < h; ++y ) {
-    const guint16 *row =
-        reinterpret_cast<const guint16 *>( reinterpret_cast<const guint8 *>( src ) + y * src_stride );
-    for ( gint x = 0; x < w; ++x ) {
-      guint v = row[x];
-      if ( v < raw_min )
-        raw_min = v;
-      if ( v > raw_max )
-        raw_max = v;
-      if ( x >= roi_x && x < roi_x + static_cast<gint>( roi_w ) && y >= roi_y &&
-           y < roi_y + static_cast<gint>( roi_h ) ) {
-        roi_sum_raw += v;
-        ++roi_count;
+  GstThermalStatsMeta *stats_meta = gst_buffer_get_thermal_stats_meta( in_frame->buffer );
+  if ( stats_meta != nullptr && scale > 0.0 ) {
+    raw_min = cK_to_raw( stats_meta->min, scale, offset );
+    raw_max = cK_to_raw( stats_meta->max, scale, offset );
+  } else {
+    for ( gint y = 0; y < h; ++y ) {
+      const guint16 *row = reinterpret_cast<const guint16 *>(
+          reinterpret_cast<const guint8 *>( src ) + y * src_stride );
+      for ( gint x = 0; x < w; ++x ) {
+        raw_min = std::min<guint>( raw_min, row[x] );
+        raw_max = std::max<guint>( raw_max, row[x] );
       }
     }
   }
+  guint64 roi_sum_raw = 0;
+  guint roi_count = roi_w * roi_h;
+  for ( gint y = roi_y; y < roi_y + static_cast<gint>( roi_h ); ++y ) {
+    const guint16 *row = reinterpret_cast<const guint16 *>(
+        reinterpret_cast<const guint8 *>( src ) + y * src_stride );
+    for ( gint x = roi_x; x < roi_x + static_cast<gint>( roi_w ); ++x ) roi_sum_raw += row[x];
+  }
 
   /* Auto range stays in raw units. */
   guint auto_min_raw = raw_min;
@@ -502,8 +585,13 @@ static GstFlowReturn gst_openseekthermalcolorize_transform_frame( GstVideoFilter
     mean_c = ( mean_ck - 27315.0 ) / 100.0;
   }
 
-  colorize_into_scratch( self, src, w, h, src_stride, raw_lo, raw_hi );
-  draw_overlay( self, w, h, roi_x, roi_y, static_cast<gint>( roi_w ), static_cast<gint>( roi_h ),
+  /* Statistics and the ROI stay at input resolution; only the rendering is
+   * upscaled. */
+  gint color_stride = src_stride;
+  const guint16 *color_src = upscale_input( self, src, w, h, &color_stride, out_w, out_h );
+  colorize_into_scratch( self, color_src, out_w, out_h, color_stride, raw_lo, raw_hi );
+  draw_overlay( self, out_w, out_h, roi_x * out_w / w, roi_y * out_h / h,
+                static_cast<gint>( roi_w ) * out_w / w, static_cast<gint>( roi_h ) * out_h / h,
                 mean_c );
   convert_scratch_to_output( self, out_frame );
 
@@ -516,7 +604,8 @@ static GstCaps *gst_openseekthermalcolorize_transform_caps( GstBaseTransform *tr
 {
   /* Strip format from the incoming caps, then intersect with the template of
    * the opposite pad so we always offer the full set of supported formats on
-   * that side while preserving width/height/framerate. */
+   * that side while preserving the framerate and the size, multiplied by the
+   * upscale factor on the source side. */
   GstCaps *other_template;
   if ( direction == GST_PAD_SINK ) {
     other_template = gst_pad_get_pad_template_caps( GST_BASE_TRANSFORM_SRC_PAD( trans ) );
@@ -524,11 +613,18 @@ static GstCaps *gst_openseekthermalcolorize_transform_caps( GstBaseTransform *tr
     other_template = gst_pad_get_pad_template_caps( GST_BASE_TRANSFORM_SINK_PAD( trans ) );
   }
 
+  GstOpenSeekThermalColorize *self = GST_OPENSEEKTHERMALCOLORIZE( trans );
+  GST_OBJECT_LOCK( self );
+  guint upscale = self->upscale;
+  GST_OBJECT_UNLOCK( self );
+
   GstCaps *result = gst_caps_new_empty();
   for ( guint i = 0; i < gst_caps_get_size( caps ); ++i ) {
     GstStructure *s = gst_structure_copy( gst_caps_get_structure( caps, i ) );
     gst_structure_remove_field( s, "format" );
     gst_structure_set_name( s, "video/x-raw" );
+    scale_size_field( s, "width", direction, upscale );
+    scale_size_field( s, "height", direction, upscale );
     gst_caps_append_structure( result, s );
   }
 
@@ -582,6 +678,11 @@ static void gst_openseekthermalcolorize_init( GstOpenSeekThermalColorize *self )
   self->roi_width = DEFAULT_ROI_WIDTH;
   self->roi_height = DEFAULT_ROI_HEIGHT;
   self->auto_range_frames = DEFAULT_AUTO_RANGE_FRAMES;
+  self->upscale = DEFAULT_UPSCALE;
+  self->upscale_method = DEFAULT_UPSCALE_METHOD;
+  self->scaler = nullptr;
+  self->upscaled = nullptr;
+  self->upscaled_size = 0;
 
   self->out_format = GST_VIDEO_FORMAT_UNKNOWN;
   self->bytes_per_pixel = 0;
@@ -607,6 +708,8 @@ static void gst_openseekthermalcolorize_finalize( GObject *object )
   g_free( self->min_values );
   g_free( self->max_values );
   g_free( self->sort_value_buffer );
+  delete self->scaler;
+  g_free( self->upscaled );
   destroy_scratch( self );
   G_OBJECT_CLASS( gst_openseekthermalcolorize_parent_class )->finalize( object );
 }
@@ -643,6 +746,17 @@ static void gst_openseekthermalcolorize_set_property( GObject *object, guint pro
     self->first_frame = TRUE;
     GST_OBJECT_UNLOCK( self );
     break;
+  case PROP_UPSCALE:
+    GST_OBJECT_LOCK( self );
+    self->upscale = g_value_get_uint( value );
+    GST_OBJECT_UNLOCK( self );
+    // The output size changes; renegotiate.
+    gst_base_transform_reconfigure_src( GST_BASE_TRANSFORM( self ) );
+    break;
+  case PROP_UPSCALE_METHOD:
+    self->upscale_method =
+        static_cast<GstOpenSeekThermalUpscaleMethod>( g_value_get_enum( value ) );
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID( object, prop_id, pspec );
     break;
@@ -672,6 +786,12 @@ static void gst_openseekthermalcolorize_get_property( GObject *object, guint pro
   case PROP_AUTO_RANGE_FRAMES:
     g_value_set_uint( value, self->auto_range_frames );
     break;
+  case PROP_UPSCALE:
+    g_value_set_uint( value, self->upscale );
+    break;
+  case PROP_UPSCALE_METHOD:
+    g_value_set_enum( value, self->upscale_method );
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID( object, prop_id, pspec );
     break;
@@ -722,6 +842,20 @@ static void gst_openseekthermalcolorize_class_init( GstOpenSeekThermalColorizeCl
                          "Rolling-median window length used to stabilize auto min/max.", 1,
                          MAX_AUTO_RANGE_FRAMES, DEFAULT_AUTO_RANGE_FRAMES,
                          (GParamFlags)( G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS ) ) );
+  g_object_class_install_property(
+      gobject_class, PROP_UPSCALE,
+      g_param_spec_uint( "upscale", "Upscale",
+                         "Output size as a multiple of the input size. The thermal data is "
+                         "interpolated before colorization, which is cheaper than scaling the "
+                         "color output downstream. 1 = sensor resolution.",
+                         1, MAX_UPSCALE, DEFAULT_UPSCALE,
+                         (GParamFlags)( G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS ) ) );
+  g_object_class_install_property(
+      gobject_class, PROP_UPSCALE_METHOD,
+      g_param_spec_enum( "upscale-method", "Upscale method",
+                         "Interpolation used if upscale is larger than 1.",
+                         GST_TYPE_OPENSEEKTHERMAL_UPSCALE_METHOD, DEFAULT_UPSCALE_METHOD,
+                         (GParamFlags)( G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS ) ) );
 
   gst_element_class_set_static_metadata(
       element_class, "OpenSeekThermal Colorize", "Filter/Effect/Video",
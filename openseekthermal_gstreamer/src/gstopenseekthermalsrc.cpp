@@ -27,10 +27,13 @@
 #include "openseekthermal_gstreamer/gstopenseekthermalsrc.h"
 
 #include "openseekthermal_gstreamer/gstthermalscalemeta.h"
+#include "openseekthermal_gstreamer/gstthermalstatsmeta.h"
 #include <openseekthermal/camera_calibration.hpp>
 #include <openseekthermal/detail/exceptions.hpp>
+#include <openseekthermal/trace.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <gst/video/gstvideometa.h>
 #include <gst/video/gstvideopool.h>
 #include <numeric>
@@ -47,6 +50,8 @@ enum {
   PROP_NORMALIZE,
   PROP_NORMALIZE_FRAME_COUNT,
   PROP_CALIBRATION,
+  PROP_BINNING,
+  PROP_DECIMATION,
   PROP_LAST
 };
 
@@ -136,9 +141,23 @@ static void gst_openseekthermalsrc_class_init( GstOpenSeekThermalSrcClass *klass
       gobject_class, PROP_CALIBRATION,
       g_param_spec_string(
           "calibration", "Calibration",
-          "Path to a calibration .ini with optional [temperature], [vignette], and "
-          "[dead_pixels] sections. If not provided, the driver uses the on-camera calibration.",
+          "Path to a calibration .ini (or its binary form) with optional [temperature], "
+          "[vignette], [dead_pixels], [non_uniformity] and [distortion] sections. If not "
+          "provided, the driver uses the on-camera calibration.",
           "", (GParamFlags)( G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS ) ) );
+  g_object_class_install_property(
+      gobject_class, PROP_BINNING,
+      g_param_spec_uint( "binning", "Binning",
+                         "Average blocks of binning x binning pixels (1, 2 or 4; 3 is rejected) in "
+                         "the driver, e.g. 160x120 frames of a 320x240 camera for 2. Applied when "
+                         "the camera is opened.",
+                         1, 4, 1, (GParamFlags)( G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS ) ) );
+  g_object_class_install_property(
+      gobject_class, PROP_DECIMATION,
+      g_param_spec_uint( "decimation", "Decimation",
+                         "Emit only every n-th thermal frame; the caps advertise the reduced "
+                         "framerate. Applied when the camera is opened.",
+                         1, 1000, 1, (GParamFlags)( G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS ) ) );
 
   element_class->change_state = gst_openseekthermalsrc_change_state;
 
@@ -181,6 +200,8 @@ static void gst_openseekthermalsrc_init( GstOpenSeekThermalSrc *ostsrc )
   ostsrc->skip_invalid_frames = TRUE;
   ostsrc->normalize = FALSE;
   ostsrc->normalize_frame_count = 8;
+  ostsrc->binning = 1;
+  ostsrc->decimation = 1;
 
   ostsrc->serial = g_strdup( "" );
   ostsrc->port = g_strdup( "" );
@@ -265,6 +286,20 @@ static void gst_openseekthermalsrc_set_property( GObject *object, guint prop_id,
     ostsrc->calibration_path = g_value_dup_string( value );
     GST_DEBUG_OBJECT( ostsrc, "Calibration path set to %s", ostsrc->calibration_path );
     break;
+  case PROP_BINNING: {
+    const guint binning = g_value_get_uint( value );
+    if ( binning == 3 ) {
+      GST_WARNING_OBJECT( ostsrc, "Binning must be 1, 2 or 4. Keeping %u.", ostsrc->binning );
+      break;
+    }
+    ostsrc->binning = binning;
+    GST_DEBUG_OBJECT( ostsrc, "Binning set to %u", ostsrc->binning );
+    break;
+  }
+  case PROP_DECIMATION:
+    ostsrc->decimation = g_value_get_uint( value );
+    GST_DEBUG_OBJECT( ostsrc, "Decimation set to %u", ostsrc->decimation );
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID( object, prop_id, pspec );
     break;
@@ -295,6 +330,12 @@ static void gst_openseekthermalsrc_get_property( GObject *object, guint prop_id,
   case PROP_CALIBRATION:
     g_value_set_string( value, ostsrc->calibration_path );
     break;
+  case PROP_BINNING:
+    g_value_set_uint( value, ostsrc->binning );
+    break;
+  case PROP_DECIMATION:
+    g_value_set_uint( value, ostsrc->decimation );
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID( object, prop_id, pspec );
     break;
@@ -310,9 +351,9 @@ static GstCaps *gst_openseekthermalsrc_get_caps( GstBaseSrc *src, GstCaps * )
     return gst_pad_get_pad_template_caps( GST_BASE_SRC_PAD( ostsrc ) );
   }
 
-  auto width = static_cast<gint>( ostsrc->camera->getFrameWidth() );
-  auto height = static_cast<gint>( ostsrc->camera->getFrameHeight() );
-  auto rate = ostsrc->camera->getMaxFramerate();
+  auto width = static_cast<gint>( ostsrc->camera->getOutputWidth() );
+  auto height = static_cast<gint>( ostsrc->camera->getOutputHeight() );
+  auto rate = ostsrc->camera->getOutputFramerate();
   GstCaps *caps = gst_caps_new_simple( "video/x-raw", "format", G_TYPE_STRING, "GRAY16_LE", "width",
                                        G_TYPE_INT, width, "height", G_TYPE_INT, height, "framerate",
                                        GST_TYPE_FRACTION, rate.numerator, rate.denominator, NULL );
@@ -334,7 +375,7 @@ static gboolean gst_openseekthermalsrc_query( GstBaseSrc *src, GstQuery *query )
       return FALSE;
     }
 
-    auto framerate = ostsrc->camera->getMaxFramerate();
+    auto framerate = ostsrc->camera->getOutputFramerate();
     // Since this is live min latency is always time to capture one frame which is the inverse of the framerate
     GstClockTime min_latency =
         gst_util_uint64_scale_int( GST_SECOND, framerate.denominator, framerate.numerator );
@@ -427,27 +468,38 @@ void update_normalization_factor( GstOpenSeekThermalSrc *ostsrc, guint min_value
 
 static GstFlowReturn gst_openseekthermalsrc_create( GstPushSrc *src, GstBuffer **buf )
 {
+  OPENSEEKTHERMAL_TRACE_SCOPE( "openseekthermalsrc::create" );
   GstOpenSeekThermalSrc *ostsrc = GST_OPENSEEKTHERMALSRC( src );
+  if ( openseekthermal::isTracingEnabled() && ostsrc->first_frame ) {
+    // Exceptions must not escape into GStreamer; the thread stays unnamed.
+    try {
+      openseekthermal::setTraceThreadName( GST_OBJECT_NAME( ostsrc ) );
+    } catch ( const std::exception &e ) {
+      GST_WARNING_OBJECT( ostsrc, "Failed to name the trace thread: %s", e.what() );
+    }
+  }
   if ( ostsrc->camera == nullptr ) {
     GST_ERROR_OBJECT( ostsrc, "Camera not available yet!" );
     return GST_FLOW_ERROR;
   }
-  GstFlowReturn ret = GST_BASE_SRC_CLASS( gst_openseekthermalsrc_parent_class )
-                          ->alloc( GST_BASE_SRC( src ), 0, ostsrc->camera->getFrameSize(), buf );
+  GstFlowReturn ret =
+      GST_BASE_SRC_CLASS( gst_openseekthermalsrc_parent_class )
+          ->alloc( GST_BASE_SRC( src ), 0, ostsrc->camera->getOutputFrameSize(), buf );
   if ( G_UNLIKELY( ret != GST_FLOW_OK ) ) {
     GST_ERROR_OBJECT( ostsrc, "Failed to allocate buffer of %lu bytes",
-                      ostsrc->camera->getFrameSize() );
+                      ostsrc->camera->getOutputFrameSize() );
     return ret;
   }
 
   GstMapInfo map;
   gst_buffer_map( *buf, &map, GST_MAP_WRITE );
   openseekthermal::FrameHeader header;
+  openseekthermal::FrameStats stats;
   int tries = 1;
   const int MAX_TRIES = 10;
   while ( tries < MAX_TRIES ) {
     try {
-      auto result = ostsrc->camera->grabFrame( &map.data, map.size, &header );
+      auto result = ostsrc->camera->grabFrame( &map.data, map.size, &header, &stats );
       if ( result != openseekthermal::GrabFrameResult::SUCCESS ) {
         GST_ERROR_OBJECT( ostsrc, "Failed to grab frame: %s",
                           openseekthermal::to_string( result ).c_str() );
@@ -479,17 +531,10 @@ static GstFlowReturn gst_openseekthermalsrc_create( GstPushSrc *src, GstBuffer *
   if ( ostsrc->normalize ) {
     gfloat scale = 1;
     gfloat offset = 0;
-    guint min_value = 65535;
-    guint max_value = 0;
-    for ( guint i = 0; i < map.size / 2; ++i ) {
-      guint value = reinterpret_cast<uint16_t *>( map.data )[i];
-      min_value = std::min( min_value, value );
-      max_value = std::max( max_value, value );
-    }
     // Lock against a concurrent set_property(normalize-frame-count) realloc of
     // the rolling-window buffers.
     GST_OBJECT_LOCK( ostsrc );
-    update_normalization_factor( ostsrc, min_value, max_value, scale, offset );
+    update_normalization_factor( ostsrc, stats.min, stats.max, scale, offset );
     GST_OBJECT_UNLOCK( ostsrc );
     GST_DEBUG_OBJECT( ostsrc, "Normalization: scale=%f, offset=%f", scale, offset );
 
@@ -504,12 +549,21 @@ static GstFlowReturn gst_openseekthermalsrc_create( GstPushSrc *src, GstBuffer *
   } else {
     gst_buffer_unmap( *buf, &map );
   }
+  static_assert( GST_THERMAL_STATS_META_HISTOGRAM_BINS ==
+                     openseekthermal::FrameStats::kHistogramBins,
+                 "Histogram bin count mismatch" );
+  GstThermalStatsMeta *stats_meta = gst_buffer_add_thermal_stats_meta( *buf );
+  stats_meta->min = stats.min;
+  stats_meta->max = stats.max;
+  stats_meta->mean = stats.mean;
+  stats_meta->sentinel_count = static_cast<guint>( stats.sentinel_count );
+  std::copy( stats.histogram.begin(), stats.histogram.end(), stats_meta->histogram );
 
   // Tag the buffer with the camera's nominal frame period so downstream
   // elements (e.g. videorate drop-only) that require a valid duration on
   // every input buffer can compute next_ts. Calibration drops just look
   // like missing frames at the same nominal rate.
-  auto max_rate = ostsrc->camera->getMaxFramerate();
+  auto max_rate = ostsrc->camera->getOutputFramerate();
   if ( max_rate.numerator > 0 ) {
     GST_BUFFER_DURATION( *buf ) =
         gst_util_uint64_scale( GST_SECOND, static_cast<guint64>( max_rate.denominator ),
@@ -549,7 +603,10 @@ static gboolean gst_openseekthermalsrc_open( GstOpenSeekThermalSrc *src )
   }
 
   try {
+    OPENSEEKTHERMAL_TRACE_SCOPE( "openseekthermalsrc::open" );
     src->camera = openseekthermal::createCamera( device );
+    src->camera->setOutputBinning( static_cast<int>( src->binning ) );
+    src->camera->setFrameDecimation( static_cast<int>( src->decimation ) );
     src->camera->open();
     src->first_frame = TRUE;
     g_free( src->serial );
@@ -566,9 +623,12 @@ static gboolean gst_openseekthermalsrc_open( GstOpenSeekThermalSrc *src )
     try {
       auto cal = openseekthermal::loadCameraCalibration(
           src->calibration_path, src->camera->getFrameWidth(), src->camera->getFrameHeight() );
-      GST_INFO_OBJECT( src, "Loaded calibration '%s' (temperature=%d, vignette=%d, dead_pixels=%zu).",
+      GST_INFO_OBJECT( src,
+                       "Loaded calibration '%s' (temperature=%d, vignette=%d, dead_pixels=%zu, "
+                       "non_uniformity=%d, distortion=%d).",
                        src->calibration_path, cal.temperature.has_value(), cal.vignette.has_value(),
-                       cal.dead_pixels ? cal.dead_pixels->deadPixelCount() : 0 );
+                       cal.dead_pixels ? cal.dead_pixels->deadPixelCount() : 0,
+                       cal.non_uniformity.has_value(), cal.distortion.has_value() );
       src->camera->setCalibration( std::move( cal ) );
     } catch ( const std::exception &e ) {
       GST_ERROR_OBJECT( src, "Failed to load calibration '%s': %s", src->calibration_path, e.what() );
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "openseekthermal_gstreamer/gstthermalstatsmeta.h"
+
+#include <gst/video/video.h>
+
+#include <cstring>
+
+GType gst_thermal_stats_meta_api_get_type( void )
+{
+  static GType type = 0;
+  // The statistics describe the pixels, so elements that change the size or
+  // the values of the frame must drop them.
+  static const gchar *tags[] = { GST_META_TAG_VIDEO_STR, GST_META_TAG_VIDEO_SIZE_STR,
+                                 GST_META_TAG_VIDEO_COLORSPACE_STR, NULL };
+  if ( g_once_init_enter( &type ) ) {
+    GType _type = gst_meta_api_type_register( "GstThermalStatsMetaAPI", tags );
+    g_once_init_leave( &type, _type );
+  }
+  return type;
+}
+
+static gboolean gst_thermal_stats_meta_init( GstMeta *meta, gpointer, GstBuffer * )
+{
+  auto *m = reinterpret_cast<GstThermalStatsMeta *>( meta );
+  m->min = 0;
+  m->max = 0;
+  m->mean = 0.0;
+  m->sentinel_count = 0;
+  std::memset( m->histogram, 0, sizeof( m->histogram ) );
+  return TRUE;
+}
+
+static gboolean gst_thermal_stats_meta_transform( GstBuffer *dest, GstMeta *meta, GstBuffer *,
+                                                  GQuark type, gpointer data )
+{
+  auto *src_meta = reinterpret_cast<GstThermalStatsMeta *>( meta );
+  // Only a copy of the whole buffer still has these statistics.
+  if ( GST_META_TRANSFORM_IS_COPY( type ) &&
+       !static_cast<GstMetaTransformCopy *>( data )->region ) {
+    GstThermalStatsMeta *m = gst_buffer_add_thermal_stats_meta( dest );
+    m->min = src_meta->min;
+    m->max = src_meta->max;
+    m->mean = src_meta->mean;
+    m->sentinel_count = src_meta->sentinel_count;
+    std::memcpy( m->histogram, src_meta->histogram, sizeof( m->histogram ) );
+  }
+  return TRUE;
+}
+
+const GstMetaInfo *gst_thermal_stats_meta_get_info( void )
+{
+  static const GstMetaInfo *info = NULL;
+  if ( g_once_init_enter( &info ) ) {
+    const GstMetaInfo *m = gst_meta_register(
+        gst_thermal_stats_meta_api_get_type(), "GstThermalStatsMeta", sizeof( GstThermalStatsMeta ),
+        gst_thermal_stats_meta_init, NULL, gst_thermal_stats_meta_transform );
+    g_once_init_leave( &info, m );
+  }
+  return info;
+}
+
+GstThermalStatsMeta *gst_buffer_add_thermal_stats_meta( GstBuffer *buffer )
+{
+  return reinterpret_cast<GstThermalStatsMeta *>(
+      gst_buffer_add_meta( buffer, GST_THERMAL_STATS_META_INFO, NULL ) );
+}